@@ -0,0 +1,26 @@
+#ifndef __BENCH_HELPER_HPP__
+#define __BENCH_HELPER_HPP__
+
+#include <filesystem>
+#include <string_view>
+
+
+namespace genesis::bench
+{
+
+[[maybe_unused]] static std::filesystem::path data_path()
+{
+	return GENESIS_BENCH_DATA_DIR;
+}
+
+// Path to ROM generated by genesis_romgen
+[[maybe_unused]] static std::filesystem::path stress_rom_path(std::string_view name)
+{
+	auto path = data_path() / "roms" / name;
+	path.replace_extension(".bin");
+	return path;
+}
+
+} // namespace genesis::bench
+
+#endif // __BENCH_HELPER_HPP__
@@ -0,0 +1,119 @@
+#include "m68k/impl/opcode_decoder.h"
+#include "m68k/test_cpu.hpp"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace genesis;
+using namespace genesis::m68k;
+
+
+namespace
+{
+
+// Load program repeated num_repeats times followed by BRA.W to the beginning
+void load_loop(test::test_cpu& cpu, const std::vector<std::uint16_t>& body, int num_repeats = 256)
+{
+	auto& mem = cpu.memory();
+
+	std::uint32_t addr = 0;
+	for(int i = 0; i < num_repeats; ++i)
+	{
+		for(auto word : body)
+		{
+			mem.write(addr, word);
+			addr += 2;
+		}
+	}
+
+	// BRA.W displacement is relative to the extension word
+	std::int16_t disp = -static_cast<std::int16_t>(addr + 2);
+	mem.write(addr, std::uint16_t(0x6000));
+	mem.write(addr + 2, static_cast<std::uint16_t>(disp));
+
+	auto& regs = cpu.registers();
+	regs.flags.TR = 0;
+	regs.flags.S = 1;
+	regs.PC = 0;
+	regs.IR = regs.IRC = regs.IRD = body.front();
+	if(body.size() > 1)
+		regs.IRC = body.at(1);
+}
+
+void run_loop(benchmark::State& state, const std::vector<std::uint16_t>& body)
+{
+	test::test_cpu cpu;
+	load_loop(cpu, body);
+
+	for(auto _ : state)
+		cpu.cycle();
+
+	state.SetItemsProcessed(state.iterations());
+	state.SetLabel("items = cycles");
+}
+
+} // namespace
+
+
+static void m68k_decode(benchmark::State& state)
+{
+	for(auto _ : state)
+	{
+		for(std::uint32_t opcode = 0; opcode <= 0xFFFF; ++opcode)
+			benchmark::DoNotOptimize(opcode_decoder::decode(opcode));
+	}
+
+	state.SetItemsProcessed(state.iterations() * 0x10000);
+}
+BENCHMARK(m68k_decode);
+
+static void m68k_bus_scheduler_read(benchmark::State& state)
+{
+	test::test_cpu cpu;
+	auto& busm = cpu.bus_manager();
+	auto& scheduler = cpu.bus_scheduler();
+
+	std::uint64_t cycles = 0;
+	for(auto _ : state)
+	{
+		scheduler.read(0, size_type::WORD, [](std::uint32_t data, size_type) { benchmark::DoNotOptimize(data); });
+		while(!busm.is_idle() || !scheduler.is_idle())
+		{
+			scheduler.cycle();
+			busm.cycle();
+			++cycles;
+		}
+	}
+
+	state.SetItemsProcessed(cycles);
+	state.SetLabel("items = cycles");
+}
+BENCHMARK(m68k_bus_scheduler_read);
+
+static void m68k_nop_loop(benchmark::State& state)
+{
+	run_loop(state, {test::nop_opcode});
+}
+BENCHMARK(m68k_nop_loop);
+
+static void m68k_alu_loop(benchmark::State& state)
+{
+	run_loop(state, {
+						0xD240, // ADD.W D0, D1
+						0x9441, // SUB.W D1, D2
+						0xC642, // AND.W D2, D3
+						0x8843, // OR.W D3, D4
+						0xB945, // EOR.W D4, D5
+						0xE34E, // LSL.W #1, D6
+					});
+}
+BENCHMARK(m68k_alu_loop);
+
+static void m68k_movem_loop(benchmark::State& state)
+{
+	run_loop(state, {
+						0x4CF8, 0x00FF, 0x8000, // MOVEM.L ($8000).W, D0-D7
+						0x48F8, 0x00FF, 0x8000, // MOVEM.L D0-D7, ($8000).W
+					});
+}
+BENCHMARK(m68k_movem_loop);
@@ -0,0 +1,49 @@
+#include "memory/dummy_memory.h"
+#include "memory/memory_builder.h"
+#include "memory/memory_unit.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace genesis;
+
+
+namespace
+{
+
+// Roughly reproduces the layout of m68k memory map
+std::shared_ptr<memory::addressable> build_m68k_like_map()
+{
+	memory::memory_builder builder;
+
+	builder.add(memory::make_memory_unit<std::endian::big>(0x3FFFFF), 0x0, 0x3FFFFF);		 // ROM
+	builder.add(memory::make_memory_unit<std::endian::little>(0xFFFF), 0xA00000, 0xA0FFFF); // z80 area
+	builder.add(std::make_shared<memory::zero_memory_unit>(0x1F), 0xA10000, 0xA1001F);		 // io ports
+	builder.add(std::make_shared<memory::zero_memory_unit>(0x1), 0xA11100, 0xA11101);		 // z80 bus request
+	builder.add(std::make_shared<memory::zero_memory_unit>(0x1), 0xA11200, 0xA11201);		 // z80 reset
+	builder.add(std::make_shared<memory::zero_memory_unit>(0x1F), 0xC00000, 0xC0001F);		 // vdp ports
+
+	builder.add(memory::make_memory_unit<std::endian::big>(0xFFFF), 0xE00000, 0xFFFFFF, 0xFFFF); // RAM + mirrors
+
+	return builder.build();
+}
+
+} // namespace
+
+
+static void memory_map_lookup(benchmark::State& state)
+{
+	auto mem_map = build_m68k_like_map();
+	const std::uint32_t address = state.range(0);
+
+	for(auto _ : state)
+	{
+		mem_map->init_read_word(address);
+		benchmark::DoNotOptimize(mem_map->latched_word());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(memory_map_lookup)
+	->Arg(0x000200)	 // ROM
+	->Arg(0xC00004)	 // VDP control port
+	->Arg(0xFF0000); // RAM mirror
@@ -0,0 +1,140 @@
+#ifndef __ROM_GEN_CARTRIDGE_H__
+#define __ROM_GEN_CARTRIDGE_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace genesis::rom_gen
+{
+
+/* Lays out vectors, header, code and data of a cartridge image */
+class cartridge
+{
+public:
+	static constexpr std::uint32_t code_start = 0x200;
+
+	// Exception vector numbers
+	static constexpr int reset_ssp = 0;
+	static constexpr int reset_pc = 1;
+	static constexpr int hint_vector = 28; // level 4 autovector
+	static constexpr int vint_vector = 30; // level 6 autovector
+
+	explicit cartridge(std::string_view name)
+	{
+		m_rom.resize(code_start, 0);
+
+		put_str(0x100, "SEGA MEGA DRIVE ");
+		put_str(0x110, "(C)GENESIS      ");
+		put_name(0x120, name);
+		put_name(0x150, name);
+		put_str(0x180, "GM 00000000-00");
+		put_str(0x190, "J               ");
+		put_long(0x1A0, 0x000000); // ROM start
+		put_long(0x1A8, 0xFF0000); // RAM start
+		put_long(0x1AC, 0xFFFFFF); // RAM end
+		put_str(0x1F0, "JUE             ");
+
+		set_vector(reset_ssp, 0xFFFE00);
+	}
+
+	void set_vector(int vector_number, std::uint32_t address)
+	{
+		put_long(vector_number * 4, address);
+	}
+
+	void set_code(std::span<const std::uint16_t> code)
+	{
+		put_words(code_start, code);
+	}
+
+	void set_data(std::uint32_t address, std::span<const std::uint16_t> data)
+	{
+		put_words(address, data);
+	}
+
+	void set_bytes(std::uint32_t address, std::span<const std::uint8_t> data)
+	{
+		ensure_size(address + data.size());
+		std::ranges::copy(data, m_rom.begin() + address);
+	}
+
+	void write(const std::filesystem::path& path)
+	{
+		// ROM size must be even and checksum covers everything after header
+		ensure_size(m_rom.size() + (m_rom.size() % 2));
+		put_long(0x1A4, static_cast<std::uint32_t>(m_rom.size() - 1)); // ROM end
+		put_word(0x18E, checksum());
+
+		std::ofstream fs(path, std::ios_base::binary);
+		if(!fs.is_open())
+			throw std::runtime_error("cartridge::write error: failed to open file '" + path.string() + "'");
+
+		fs.write(reinterpret_cast<const char*>(m_rom.data()), m_rom.size());
+	}
+
+private:
+	std::uint16_t checksum() const
+	{
+		std::uint16_t sum = 0;
+		for(std::size_t i = code_start; i + 1 < m_rom.size(); i += 2)
+			sum += (m_rom[i] << 8) | m_rom[i + 1];
+		return sum;
+	}
+
+	void ensure_size(std::size_t size)
+	{
+		if(m_rom.size() < size)
+			m_rom.resize(size, 0);
+	}
+
+	void put_word(std::uint32_t address, std::uint16_t word)
+	{
+		ensure_size(address + 2);
+		m_rom[address] = word >> 8;
+		m_rom[address + 1] = word & 0xFF;
+	}
+
+	void put_long(std::uint32_t address, std::uint32_t data)
+	{
+		put_word(address, data >> 16);
+		put_word(address + 2, data & 0xFFFF);
+	}
+
+	void put_words(std::uint32_t address, std::span<const std::uint16_t> words)
+	{
+		for(auto word : words)
+		{
+			put_word(address, word);
+			address += 2;
+		}
+	}
+
+	void put_str(std::uint32_t address, std::string_view str)
+	{
+		ensure_size(address + str.size());
+		std::ranges::copy(str, m_rom.begin() + address);
+	}
+
+	// names occupy 48 bytes and are padded with spaces
+	void put_name(std::uint32_t address, std::string_view name)
+	{
+		std::string padded(48, ' ');
+		std::ranges::copy(name.substr(0, padded.size()), padded.begin());
+		put_str(address, padded);
+	}
+
+private:
+	std::vector<std::uint8_t> m_rom;
+};
+
+} // namespace genesis::rom_gen
+
+#endif // __ROM_GEN_CARTRIDGE_H__
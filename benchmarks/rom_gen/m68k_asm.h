@@ -0,0 +1,247 @@
+#ifndef __ROM_GEN_M68K_ASM_H__
+#define __ROM_GEN_M68K_ASM_H__
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+namespace genesis::rom_gen
+{
+
+/* Tiny m68k assembler, supports only instructions/addressing modes needed by stress ROMs */
+class m68k_asm
+{
+public:
+	using label = std::size_t;
+
+	explicit m68k_asm(std::uint32_t origin) : m_origin(origin)
+	{
+	}
+
+	std::uint32_t pc() const
+	{
+		return m_origin + static_cast<std::uint32_t>(m_code.size() * 2);
+	}
+
+	label new_label()
+	{
+		m_labels.push_back(unbound);
+		return m_labels.size() - 1;
+	}
+
+	void bind(label l)
+	{
+		if(m_labels.at(l) != unbound)
+			throw std::logic_error("label is already bound");
+		m_labels.at(l) = pc();
+	}
+
+	label here()
+	{
+		auto l = new_label();
+		bind(l);
+		return l;
+	}
+
+	std::uint32_t address(label l) const
+	{
+		if(m_labels.at(l) == unbound)
+			throw std::logic_error("label is not bound");
+		return m_labels.at(l);
+	}
+
+	// resolve all label references and return the code
+	const std::vector<std::uint16_t>& finish()
+	{
+		for(const auto& fix : m_fixups)
+		{
+			std::uint32_t target = address(fix.target);
+			if(fix.relative)
+			{
+				std::int32_t disp = static_cast<std::int32_t>(target) - static_cast<std::int32_t>(fix.base);
+				if(disp < std::numeric_limits<std::int16_t>::min() || disp > std::numeric_limits<std::int16_t>::max())
+					throw std::logic_error("branch displacement is out of range");
+				m_code.at(fix.pos) = static_cast<std::uint16_t>(disp);
+			}
+			else
+			{
+				m_code.at(fix.pos) = target >> 16;
+				m_code.at(fix.pos + 1) = target & 0xFFFF;
+			}
+		}
+
+		m_fixups.clear();
+		return m_code;
+	}
+
+	/* raw data */
+
+	void dw(std::uint16_t word)
+	{
+		m_code.push_back(word);
+	}
+
+	void dl(std::uint32_t data)
+	{
+		dw(data >> 16);
+		dw(data & 0xFFFF);
+	}
+
+	/* instructions */
+
+	// MOVE.B #imm, (xxx).L
+	void move_b(std::uint8_t imm, std::uint32_t abs_addr)
+	{
+		dw(0x13FC);
+		dw(imm);
+		dl(abs_addr);
+	}
+
+	// MOVE.W #imm, (xxx).L
+	void move_w(std::uint16_t imm, std::uint32_t abs_addr)
+	{
+		dw(0x33FC);
+		dw(imm);
+		dl(abs_addr);
+	}
+
+	// MOVE.L #imm, (xxx).L
+	void move_l(std::uint32_t imm, std::uint32_t abs_addr)
+	{
+		dw(0x23FC);
+		dl(imm);
+		dl(abs_addr);
+	}
+
+	// MOVE.W #imm, Dn
+	void move_w_imm_d(std::uint16_t imm, int dn)
+	{
+		dw(0x303C | (dn << 9));
+		dw(imm);
+	}
+
+	// MOVE.W Dn, (xxx).L
+	void move_w_d_abs(int dn, std::uint32_t abs_addr)
+	{
+		dw(0x33C0 | dn);
+		dl(abs_addr);
+	}
+
+	// MOVE.W (An)+, (xxx).L
+	void move_w_postinc_abs(int an, std::uint32_t abs_addr)
+	{
+		dw(0x33D8 | an);
+		dl(abs_addr);
+	}
+
+	// MOVE.B (An)+, (Am)+
+	void move_b_postinc_postinc(int an, int am)
+	{
+		dw(0x10D8 | (am << 9) | an);
+	}
+
+	// MOVEA.L #imm, An
+	void movea_l(std::uint32_t imm, int an)
+	{
+		dw(0x207C | (an << 9));
+		dl(imm);
+	}
+
+	// MOVEA.L #label, An
+	void movea_l(label l, int an)
+	{
+		dw(0x207C | (an << 9));
+		add_abs_fixup(l);
+	}
+
+	// MOVE.W #imm, SR
+	void move_to_sr(std::uint16_t imm)
+	{
+		dw(0x46FC);
+		dw(imm);
+	}
+
+	// ADDQ.W #q, Dn (q = 1..8)
+	void addq_w(int q, int dn)
+	{
+		dw(0x5040 | ((q & 0b111) << 9) | dn);
+	}
+
+	// ADDQ.L #q, Dn (q = 1..8)
+	void addq_l(int q, int dn)
+	{
+		dw(0x5080 | ((q & 0b111) << 9) | dn);
+	}
+
+	// ADD.W Dn, Dm
+	void add_w(int dn, int dm)
+	{
+		dw(0xD040 | (dm << 9) | dn);
+	}
+
+	// MOVE.W Dn, Dm
+	void move_w_d_d(int dn, int dm)
+	{
+		dw(0x3000 | (dm << 9) | dn);
+	}
+
+	// DBRA Dn, label
+	void dbra(int dn, label l)
+	{
+		dw(0x51C8 | dn);
+		add_rel_fixup(l);
+	}
+
+	// BRA.W label
+	void bra(label l)
+	{
+		dw(0x6000);
+		add_rel_fixup(l);
+	}
+
+	void nop()
+	{
+		dw(0x4E71);
+	}
+
+	void rte()
+	{
+		dw(0x4E73);
+	}
+
+private:
+	void add_rel_fixup(label l)
+	{
+		// displacement is relative to the extension word
+		m_fixups.push_back({m_code.size(), l, true, pc()});
+		dw(0);
+	}
+
+	void add_abs_fixup(label l)
+	{
+		m_fixups.push_back({m_code.size(), l, false, 0});
+		dl(0);
+	}
+
+private:
+	struct fixup
+	{
+		std::size_t pos;
+		label target;
+		bool relative;
+		std::uint32_t base;
+	};
+
+	static constexpr std::uint32_t unbound = std::numeric_limits<std::uint32_t>::max();
+
+	std::uint32_t m_origin;
+	std::vector<std::uint16_t> m_code;
+	std::vector<std::uint32_t> m_labels;
+	std::vector<fixup> m_fixups;
+};
+
+} // namespace genesis::rom_gen
+
+#endif // __ROM_GEN_M68K_ASM_H__
@@ -0,0 +1,409 @@
+#include "cartridge.h"
+#include "m68k_asm.h"
+
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <optional>
+
+
+/*
+ * Generates synthetic cartridges used by genesis_bench.
+ *
+ * Usage: genesis_romgen <output directory>
+ */
+
+using namespace genesis::rom_gen;
+
+namespace
+{
+
+/* Memory map */
+
+constexpr std::uint32_t vdp_data = 0xC00000;
+constexpr std::uint32_t vdp_ctrl = 0xC00004;
+constexpr std::uint32_t z80_ram = 0xA00000;
+constexpr std::uint32_t z80_bus_request = 0xA11100;
+constexpr std::uint32_t z80_reset = 0xA11200;
+
+/* ROM data layout */
+
+constexpr std::uint32_t tiles_addr = 0x10000;
+constexpr std::uint16_t tiles_words = 0x1000; // 256 tiles
+constexpr std::uint32_t palette_addr = 0x12000;
+constexpr std::uint16_t palette_words = 64;
+constexpr std::uint32_t sat_data_addr = 0x12100;
+constexpr std::uint32_t z80_prog_addr = 0x13000;
+
+/* VRAM layout */
+
+constexpr std::uint32_t vram_hscroll = 0xAC00; // R13 = 0x2B
+constexpr std::uint32_t vram_sat = 0xB800;	   // R5 = 0x5C
+constexpr std::uint32_t vram_plane_a = 0xC000; // R2 = 0x30
+constexpr std::uint32_t vram_plane_b = 0xE000; // R4 = 0x07
+constexpr std::uint16_t plane_entries = 64 * 32;
+
+constexpr int num_sprites = 80;
+
+constexpr std::uint32_t dma_flag = 0x80;
+
+constexpr std::uint16_t vdp_reg(int reg, std::uint8_t value)
+{
+	return 0x8000 | (reg << 8) | value;
+}
+
+constexpr std::uint32_t vram_write(std::uint32_t addr)
+{
+	return ((0x4000 | (addr & 0x3FFF)) << 16) | ((addr >> 14) & 0b11);
+}
+
+constexpr std::uint32_t cram_write(std::uint32_t addr)
+{
+	return (0xC000 | (addr & 0x3FFF)) << 16;
+}
+
+constexpr std::uint32_t vsram_write(std::uint32_t addr)
+{
+	return ((0x4000 | (addr & 0x3FFF)) << 16) | 0x10;
+}
+
+/* Data */
+
+std::vector<std::uint16_t> make_tiles()
+{
+	std::vector<std::uint16_t> tiles(tiles_words);
+	for(std::size_t i = 0; i < tiles.size(); ++i)
+	{
+		// every pixel is non-transparent and neighbour pixels use different colors
+		std::uint16_t base = (i * 7) & 0xF;
+		tiles[i] = ((base | 1) << 12) | (((base + 3) | 1) << 8) | (((base + 5) | 1) << 4) | ((base + 9) | 1);
+	}
+	return tiles;
+}
+
+std::vector<std::uint16_t> make_palette()
+{
+	std::vector<std::uint16_t> palette(palette_words);
+	for(std::size_t i = 0; i < palette.size(); ++i)
+		palette[i] = (i * 0x123) & 0x0EEE;
+	return palette;
+}
+
+// 4 rows of 20 linked 32x32 sprites, so every row hits the per-line sprite limit
+std::vector<std::uint16_t> make_sprite_table()
+{
+	std::vector<std::uint16_t> sat;
+	for(int i = 0; i < num_sprites; ++i)
+	{
+		std::uint16_t link = (i + 1) < num_sprites ? i + 1 : 0;
+
+		sat.push_back(128 + (i / 20) * 56);					 // vertical position
+		sat.push_back((0b1111 << 8) | link);				 // 4x4 cells + link
+		sat.push_back(((i % 4) << 13) | ((i * 16) & 0x7FF)); // palette + pattern
+		sat.push_back(128 + (i % 20) * 16);					 // horizontal position
+	}
+	return sat;
+}
+
+// Z80 program switching 68k bank on every iteration and reading from the bank area
+std::vector<std::uint8_t> make_z80_bank_loop()
+{
+	std::vector<std::uint8_t> prog = {
+		0xF3,			  // DI
+		0x31, 0x00, 0x20, // LD SP, 0x2000
+		0x21, 0x00, 0x60, // LD HL, 0x6000
+		0x06, 0x00,		  // LD B, 0
+	};
+
+	const std::uint8_t loop = static_cast<std::uint8_t>(prog.size());
+
+	prog.push_back(0x78); // LD A, B
+	for(int i = 0; i < 8; ++i)
+	{
+		prog.push_back(0x77); // LD (HL), A
+		prog.push_back(0x0F); // RRCA
+	}
+
+	const std::vector<std::uint8_t> tail = {
+		0x36, 0x00,				// LD (HL), 0 - 9th bank bit
+		0x3A, 0x00, 0x80,		// LD A, (0x8000)
+		0xED, 0x5B, 0x00, 0x81, // LD DE, (0x8100)
+		0x04,					// INC B
+		0xCB, 0xB8,				// RES 7, B - stay within ROM banks
+		0xC3, loop, 0x00,		// JP loop
+	};
+	prog.insert(prog.end(), tail.begin(), tail.end());
+
+	return prog;
+}
+
+/* Code */
+
+void copy_to_vdp(m68k_asm& a, std::uint32_t command, std::uint32_t src, std::uint16_t num_words)
+{
+	a.move_l(command, vdp_ctrl);
+	a.movea_l(src, 0);
+	a.move_w_imm_d(num_words - 1, 0);
+	auto loop = a.here();
+	a.move_w_postinc_abs(0, vdp_data);
+	a.dbra(0, loop);
+}
+
+void fill_name_table(m68k_asm& a, std::uint32_t plane_addr)
+{
+	a.move_l(vram_write(plane_addr), vdp_ctrl);
+	a.move_w_imm_d(plane_entries - 1, 0);
+	auto loop = a.here();
+	a.move_w_d_abs(1, vdp_data);
+	a.addq_w(1, 1);
+	a.dbra(0, loop);
+}
+
+void emit_vdp_init(m68k_asm& a, std::uint8_t scroll_mode = 0x00)
+{
+	const std::array<std::uint16_t, 16> regs = {
+		vdp_reg(0, 0x04),  // no HINT
+		vdp_reg(1, 0x74),  // display, VINT, DMA, mode 5, V28
+		vdp_reg(2, 0x30),  // plane A
+		vdp_reg(3, 0x2C),  // window
+		vdp_reg(4, 0x07),  // plane B
+		vdp_reg(5, 0x5C),  // sprite table
+		vdp_reg(7, 0x00),  // background color
+		vdp_reg(10, 0xFF), // HINT counter
+		vdp_reg(11, scroll_mode),
+		vdp_reg(12, 0x81), // H40
+		vdp_reg(13, 0x2B), // hscroll table
+		vdp_reg(15, 0x02), // auto increment
+		vdp_reg(16, 0x01), // 64x32 planes
+		vdp_reg(17, 0x00), // no window
+		vdp_reg(18, 0x00),
+		vdp_reg(23, 0x00),
+	};
+
+	for(auto reg : regs)
+		a.move_w(reg, vdp_ctrl);
+
+	copy_to_vdp(a, cram_write(0), palette_addr, palette_words);
+	copy_to_vdp(a, vram_write(0), tiles_addr, tiles_words);
+
+	a.move_w_imm_d(0, 1);
+	fill_name_table(a, vram_plane_a);
+	fill_name_table(a, vram_plane_b);
+}
+
+void emit_main_loop(m68k_asm& a)
+{
+	a.move_to_sr(0x2000); // enable interrupts
+
+	auto main_loop = a.here();
+	a.addq_l(1, 7);
+	a.bra(main_loop);
+}
+
+void write_cartridge(const std::filesystem::path& out_dir, std::string_view name, m68k_asm& a,
+					 std::optional<m68k_asm::label> vint_handler,
+					 const std::function<void(cartridge&)>& add_data = nullptr)
+{
+	cartridge cart(name);
+
+	// all exceptions are ignored
+	auto default_handler = a.here();
+	a.rte();
+
+	auto& code = a.finish();
+
+	for(int vec = 2; vec < 64; ++vec)
+		cart.set_vector(vec, a.address(default_handler));
+	if(vint_handler)
+		cart.set_vector(cartridge::vint_vector, a.address(*vint_handler));
+	cart.set_vector(cartridge::reset_pc, cartridge::code_start);
+
+	if(cartridge::code_start + code.size() * 2 > tiles_addr)
+		throw std::logic_error("code overlaps with data");
+
+	cart.set_code(code);
+	cart.set_data(tiles_addr, make_tiles());
+	cart.set_data(palette_addr, make_palette());
+	if(add_data)
+		add_data(cart);
+
+	auto path = out_dir / name;
+	path.replace_extension(".bin");
+	cart.write(path);
+
+	std::cout << "Generated " << path.string() << '\n';
+}
+
+/* Cartridges */
+
+// BRA * without any setup
+void gen_idle_loop(const std::filesystem::path& out_dir)
+{
+	m68k_asm a(cartridge::code_start);
+	auto loop = a.here();
+	a.bra(loop);
+
+	write_cartridge(out_dir, "idle_loop", a, std::nullopt);
+}
+
+// ALU instructions without any setup
+void gen_alu_loop(const std::filesystem::path& out_dir)
+{
+	m68k_asm a(cartridge::code_start);
+	auto loop = a.here();
+	a.addq_l(1, 0);
+	a.add_w(0, 1);
+	a.move_w_d_d(1, 2);
+	a.add_w(2, 3);
+	a.bra(loop);
+
+	write_cartridge(out_dir, "alu_loop", a, std::nullopt);
+}
+
+// 80 linked sprites, X positions are updated every VINT
+void gen_sprites(const std::filesystem::path& out_dir)
+{
+	m68k_asm a(cartridge::code_start);
+
+	emit_vdp_init(a);
+	copy_to_vdp(a, vram_write(vram_sat), sat_data_addr, num_sprites * 4);
+	emit_main_loop(a);
+
+	auto vint = a.here();
+	a.move_w(vdp_reg(15, 8), vdp_ctrl); // step over sprite entries
+	a.move_l(vram_write(vram_sat + 6), vdp_ctrl);
+	a.move_w_d_d(6, 0);
+	a.move_w_imm_d(num_sprites - 1, 1);
+	auto loop = a.here();
+	a.move_w_d_abs(0, vdp_data);
+	a.addq_w(3, 0);
+	a.dbra(1, loop);
+	a.move_w(vdp_reg(15, 2), vdp_ctrl);
+	a.addq_w(1, 6);
+	a.rte();
+
+	write_cartridge(out_dir, "sprites", a, vint,
+					[](cartridge& cart) { cart.set_data(sat_data_addr, make_sprite_table()); });
+}
+
+// Per-line horizontal scroll and per-column vertical scroll, both tables are rewritten every VINT
+void gen_line_scroll(const std::filesystem::path& out_dir)
+{
+	m68k_asm a(cartridge::code_start);
+
+	emit_vdp_init(a, 0b111); // 2-cell vertical scroll, per-line horizontal scroll
+	emit_main_loop(a);
+
+	auto vint = a.here();
+
+	a.move_l(vram_write(vram_hscroll), vdp_ctrl);
+	a.move_w_d_d(6, 0);
+	a.move_w_imm_d(224 - 1, 1);
+	auto hscroll_loop = a.here();
+	a.move_w_d_abs(0, vdp_data); // plane A
+	a.move_w_d_abs(0, vdp_data); // plane B
+	a.addq_w(1, 0);
+	a.dbra(1, hscroll_loop);
+
+	a.move_l(vsram_write(0), vdp_ctrl);
+	a.move_w_d_d(6, 0);
+	a.move_w_imm_d(40 - 1, 1);
+	auto vscroll_loop = a.here();
+	a.move_w_d_abs(0, vdp_data);
+	a.addq_w(2, 0);
+	a.dbra(1, vscroll_loop);
+
+	a.addq_w(1, 6);
+	a.rte();
+
+	write_cartridge(out_dir, "line_scroll", a, vint);
+}
+
+// 8KB 68k -> VRAM and full palette 68k -> CRAM DMA every VINT
+void gen_dma(const std::filesystem::path& out_dir)
+{
+	m68k_asm a(cartridge::code_start);
+
+	emit_vdp_init(a);
+	emit_main_loop(a);
+
+	auto dma = [&a](std::uint32_t src, std::uint16_t num_words, std::uint32_t command) {
+		a.move_w(vdp_reg(19, num_words & 0xFF), vdp_ctrl);
+		a.move_w(vdp_reg(20, num_words >> 8), vdp_ctrl);
+		a.move_w(vdp_reg(21, (src >> 1) & 0xFF), vdp_ctrl);
+		a.move_w(vdp_reg(22, (src >> 9) & 0xFF), vdp_ctrl);
+		a.move_w(vdp_reg(23, (src >> 17) & 0x7F), vdp_ctrl);
+		a.move_l(command | dma_flag, vdp_ctrl);
+	};
+
+	auto vint = a.here();
+	dma(tiles_addr, tiles_words, vram_write(0));
+	dma(palette_addr, palette_words, cram_write(0));
+	a.addq_w(1, 6);
+	a.rte();
+
+	write_cartridge(out_dir, "dma", a, vint);
+}
+
+// Z80 switches 68k bank and reads banked ROM in a loop, while 68k is idle
+void gen_z80_bank(const std::filesystem::path& out_dir)
+{
+	const auto z80_prog = make_z80_bank_loop();
+
+	m68k_asm a(cartridge::code_start);
+
+	emit_vdp_init(a);
+
+	// Z80 bus is granted and Z80 is held in reset after power on
+	a.movea_l(z80_prog_addr, 0);
+	a.movea_l(z80_ram, 1);
+	a.move_w_imm_d(static_cast<std::uint16_t>(z80_prog.size() - 1), 0);
+	auto copy_loop = a.here();
+	a.move_b_postinc_postinc(0, 1);
+	a.dbra(0, copy_loop);
+
+	a.move_w(0x100, z80_reset);		 // release reset
+	a.move_w(0x000, z80_bus_request); // release bus
+
+	emit_main_loop(a);
+
+	auto vint = a.here();
+	a.addq_w(1, 6);
+	a.rte();
+
+	write_cartridge(out_dir, "z80_bank", a, vint,
+					[&z80_prog](cartridge& cart) { cart.set_bytes(z80_prog_addr, z80_prog); });
+}
+
+} // namespace
+
+
+int main(int args, char* argv[])
+{
+	if(args != 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <output directory>\n";
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		std::filesystem::path out_dir = argv[1];
+		std::filesystem::create_directories(out_dir);
+
+		gen_idle_loop(out_dir);
+		gen_alu_loop(out_dir);
+		gen_sprites(out_dir);
+		gen_line_scroll(out_dir);
+		gen_dma(out_dir);
+		gen_z80_bank(out_dir);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
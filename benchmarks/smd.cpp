@@ -0,0 +1,79 @@
+#include "helper.hpp"
+#include "smd/smd.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+using namespace genesis;
+
+
+namespace
+{
+
+class null_input_device : public io_ports::input_device
+{
+public:
+	bool is_key_pressed(io_ports::key_type) override
+	{
+		return false;
+	}
+};
+
+// Let ROM to initialize VDP/Z80 before measuring
+constexpr int warmup_frames = 10;
+
+} // namespace
+
+
+// Emulate and render full frames of generated stress ROM, see rom_gen/stress_roms.cpp
+static void smd_full_frame(benchmark::State& state, std::string_view rom_name, bool skip_idle_loops = false)
+{
+	genesis::rom rom(bench::stress_rom_path(rom_name).string());
+	genesis::smd smd(rom, std::make_shared<null_input_device>());
+	if(skip_idle_loops)
+		smd.enable_idle_loop_skipping();
+
+	static std::array<vdp::output_color, 1024> buffer;
+
+	bool frame_end = false;
+	smd.on_frame_end([&]() {
+		// render the same way frontend does
+		auto& render = smd.vdp().render();
+		for(unsigned row = 0; row < render.active_display_height(); ++row)
+			benchmark::DoNotOptimize(render.get_active_display_row(row, buffer));
+
+		frame_end = true;
+	});
+
+	auto run_frame = [&]() {
+		std::uint64_t cycles = 0;
+
+		frame_end = false;
+		while(!frame_end)
+		{
+			smd.cycle();
+			++cycles;
+		}
+
+		return cycles;
+	};
+
+	for(int i = 0; i < warmup_frames; ++i)
+		run_frame();
+
+	std::uint64_t cycles = 0;
+	for(auto _ : state)
+		cycles += run_frame();
+
+	state.SetItemsProcessed(state.iterations());
+	state.SetLabel("items = frames");
+	state.counters["master_cycles"] = benchmark::Counter(cycles, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(smd_full_frame, idle_loop, "idle_loop")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(smd_full_frame, idle_loop_skipped, "idle_loop", true)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(smd_full_frame, alu_loop, "alu_loop")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(smd_full_frame, sprites, "sprites")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(smd_full_frame, line_scroll, "line_scroll")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(smd_full_frame, dma, "dma")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(smd_full_frame, z80_bank, "z80_bank")->Unit(benchmark::kMillisecond);
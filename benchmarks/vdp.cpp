@@ -0,0 +1,169 @@
+#include "vdp/test_vdp.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+using namespace genesis;
+using namespace genesis::vdp;
+
+
+namespace
+{
+
+// Fill VRAM/CRAM/VSRAM with non-zero pattern, so every layer has something to render
+void fill_video_memory(test::vdp& vdp)
+{
+	std::uint8_t val = 0;
+	for(std::uint32_t addr = 0; addr <= vdp.vram().max_address(); ++addr)
+		vdp.vram().write<std::uint8_t>(addr, val += 37);
+
+	for(int addr = 0; addr <= 126; addr += 2)
+		vdp.cram().write(addr, std::uint16_t(addr * 0x21));
+
+	for(int addr = 0; addr <= 78; addr += 2)
+		vdp.vsram().write(addr, std::uint16_t(addr));
+}
+
+void write_control(test::vdp& vdp, control_register control)
+{
+	auto& ports = vdp.io_ports();
+
+	ports.init_write_control(control.raw_c1());
+	vdp.wait_io_ports();
+
+	ports.init_write_control(control.raw_c2());
+	vdp.wait_io_ports();
+}
+
+control_register dma_control(std::uint16_t dst_addr)
+{
+	control_register control;
+	control.address(dst_addr);
+	control.dma_start(true);
+	control.vmem_type(vmem_type::vram);
+	control.control_type(control_type::write);
+	control.work_completed(true);
+	return control;
+}
+
+} // namespace
+
+
+static void vdp_render_line(benchmark::State& state, display_width width)
+{
+	test::vdp vdp;
+	fill_video_memory(vdp);
+
+	auto& regs = vdp.registers();
+	regs.R12.RS0 = width == display_width::c40 ? 1 : 0;
+
+	static std::array<output_color, 1024> buffer;
+
+	auto& render = vdp.render();
+	const unsigned height = render.active_display_height();
+
+	unsigned row = 0;
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(render.get_active_display_row(row, buffer));
+		row = (row + 1) % height;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.SetLabel("items = lines");
+}
+BENCHMARK_CAPTURE(vdp_render_line, h32, display_width::c32);
+BENCHMARK_CAPTURE(vdp_render_line, h40, display_width::c40);
+
+static void vdp_dma_fill(benchmark::State& state)
+{
+	test::vdp vdp;
+	auto& sett = vdp.sett();
+	auto& regs = vdp.registers();
+
+	const std::uint16_t length = state.range(0);
+	std::uint64_t cycles = 0;
+
+	for(auto _ : state)
+	{
+		regs.R1.M1 = 1; // enable DMA
+		regs.R15.INC = 1;
+		sett.dma_length(length);
+		sett.dma_mode(dma_mode::vram_fill);
+
+		auto control = dma_control(0);
+		control.work_completed(false);
+		write_control(vdp, control);
+
+		vdp.io_ports().init_write_data(std::uint16_t(0xABCD));
+		vdp.wait_io_ports();
+
+		cycles += vdp.wait_dma_start();
+		cycles += vdp.wait_dma();
+	}
+
+	state.SetBytesProcessed(state.iterations() * length);
+	state.counters["vdp_cycles"] = benchmark::Counter(cycles, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(vdp_dma_fill)->Arg(0x1000);
+
+static void vdp_dma_vram_copy(benchmark::State& state)
+{
+	test::vdp vdp;
+	fill_video_memory(vdp);
+
+	auto& sett = vdp.sett();
+	auto& regs = vdp.registers();
+
+	const std::uint16_t length = state.range(0);
+	const std::uint16_t src_addr = 0x8000;
+	std::uint64_t cycles = 0;
+
+	for(auto _ : state)
+	{
+		regs.R1.M1 = 1; // enable DMA
+		regs.R15.INC = 1;
+		sett.dma_length(length);
+		sett.dma_mode(dma_mode::vram_copy);
+		regs.R21.L = endian::lsb(src_addr);
+		regs.R22.M = endian::msb(src_addr);
+
+		write_control(vdp, dma_control(0));
+
+		cycles += vdp.wait_dma_start();
+		cycles += vdp.wait_dma();
+	}
+
+	state.SetBytesProcessed(state.iterations() * length);
+	state.counters["vdp_cycles"] = benchmark::Counter(cycles, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(vdp_dma_vram_copy)->Arg(0x1000);
+
+static void vdp_dma_m68k_copy(benchmark::State& state)
+{
+	test::vdp vdp;
+	auto& sett = vdp.sett();
+	auto& regs = vdp.registers();
+
+	const std::uint16_t length = state.range(0); // in words
+	std::uint64_t cycles = 0;
+
+	for(auto _ : state)
+	{
+		regs.R1.M1 = 1; // enable DMA
+		regs.R15.INC = 2;
+		sett.dma_length(length);
+		sett.dma_source(0);
+		sett.dma_mode(dma_mode::mem_to_vram);
+
+		write_control(vdp, dma_control(0));
+
+		cycles += vdp.wait_dma_start();
+		cycles += vdp.wait_dma();
+		cycles += vdp.wait_fifo();
+	}
+
+	state.SetBytesProcessed(state.iterations() * length * 2);
+	state.counters["vdp_cycles"] = benchmark::Counter(cycles, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(vdp_dma_m68k_copy)->Arg(0x800);
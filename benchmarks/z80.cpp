@@ -0,0 +1,61 @@
+#include "helper.hpp"
+#include "z80/cpu.h"
+#include "z80/io_ports.hpp"
+
+#include <benchmark/benchmark.h>
+#include <fstream>
+
+using namespace genesis;
+
+
+namespace
+{
+
+class null_io_ports : public z80::io_ports
+{
+public:
+	std::uint8_t in(std::uint8_t /*dev*/, std::uint8_t /*param*/) override
+	{
+		return 0xBF;
+	}
+
+	void out(std::uint8_t /*dev*/, std::uint8_t /*param*/, std::uint8_t /*data*/) override
+	{
+	}
+};
+
+void load_zex(z80::cpu& cpu, const std::filesystem::path& bin_path)
+{
+	std::ifstream fs(bin_path, std::ios_base::binary);
+	if(!fs.is_open())
+		throw std::runtime_error("load_zex error: failed to open file '" + bin_path.string() + "'");
+
+	auto& mem = cpu.memory();
+	z80::memory::address offset = cpu.registers().PC;
+	for(char c; fs.get(c);)
+		mem.write(offset++, c);
+
+	// the same patches as in tests: return from the Spectrum ROM calls
+	mem.write<std::uint8_t>(0x1601, 0xC9);	// RET
+	mem.write<std::uint16_t>(0x10, 0x01D3); // OUT (1), A
+	mem.write<std::uint8_t>(0x12, 0xC9);	// RET
+}
+
+} // namespace
+
+
+static void z80_zexdoc(benchmark::State& state)
+{
+	auto cpu = z80::cpu(std::make_shared<z80::memory>(), std::make_shared<null_io_ports>());
+
+	cpu.registers().PC = 0x8000;
+	load_zex(cpu, bench::data_path() / "z80" / "zexdoc");
+
+	// zexdoc takes billions of instructions to complete, so measure throughput on its prefix
+	for(auto _ : state)
+		cpu.execute_one();
+
+	state.SetItemsProcessed(state.iterations());
+	state.SetLabel("items = instructions");
+}
+BENCHMARK(z80_zexdoc);
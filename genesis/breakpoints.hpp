@@ -0,0 +1,219 @@
+#ifndef __BREAKPOINTS_HPP__
+#define __BREAKPOINTS_HPP__
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace genesis
+{
+
+enum class break_type
+{
+	// stop before executing the instruction at the address
+	execution,
+
+	// notify after the memory at the address was accessed
+	read,
+	write,
+};
+
+struct break_event
+{
+	break_type type;
+	std::uint32_t address;
+};
+
+using break_handler = std::function<void(const break_event&)>;
+
+// One bit per (1 << GranularityShift) bytes of (1 << AddressBits) bytes address space
+template <unsigned AddressBits, unsigned GranularityShift>
+class address_bitmap
+{
+	static_assert(AddressBits > GranularityShift + 6);
+
+public:
+	address_bitmap() : m_words(std::size_t(1) << (AddressBits - GranularityShift - 6))
+	{
+	}
+
+	void set(std::uint32_t address)
+	{
+		auto& word = m_words[word_index(address)];
+		auto mask = bit_mask(address);
+
+		if((word & mask) == 0)
+			++m_count;
+		word |= mask;
+	}
+
+	void reset(std::uint32_t address)
+	{
+		auto& word = m_words[word_index(address)];
+		auto mask = bit_mask(address);
+
+		if((word & mask) != 0)
+			--m_count;
+		word &= ~mask;
+	}
+
+	bool test(std::uint32_t address) const
+	{
+		return (m_words[word_index(address)] & bit_mask(address)) != 0;
+	}
+
+	bool empty() const
+	{
+		return m_count == 0;
+	}
+
+	void clear()
+	{
+		std::ranges::fill(m_words, 0);
+		m_count = 0;
+	}
+
+private:
+	static std::size_t bit_index(std::uint32_t address)
+	{
+		return (address & address_mask) >> GranularityShift;
+	}
+
+	static std::size_t word_index(std::uint32_t address)
+	{
+		return bit_index(address) >> 6;
+	}
+
+	static std::uint64_t bit_mask(std::uint32_t address)
+	{
+		return std::uint64_t(1) << (bit_index(address) & 63);
+	}
+
+private:
+	static constexpr std::uint32_t address_mask = (std::uint32_t(1) << AddressBits) - 1;
+
+	std::vector<std::uint64_t> m_words;
+	std::size_t m_count = 0;
+};
+
+/* Execution breakpoints and memory watchpoints of a single cpu.
+ *
+ * CPUs check breakpoints only while at least one of them is set,
+ * so there is no cost when the debugger is not used.
+ */
+template <unsigned AddressBits, unsigned GranularityShift>
+class breakpoints
+{
+public:
+	void add(break_type type, std::uint32_t address)
+	{
+		bitmap(type).set(address);
+
+		// new breakpoint must be hit even if execution was stopped at the same address before
+		if(type == break_type::execution)
+			m_resume_address.reset();
+	}
+
+	void remove(break_type type, std::uint32_t address)
+	{
+		bitmap(type).reset(address);
+	}
+
+	void clear()
+	{
+		m_execution.clear();
+		m_read.clear();
+		m_write.clear();
+		m_resume_address.reset();
+	}
+
+	bool empty(break_type type) const
+	{
+		return bitmap(type).empty();
+	}
+
+	bool has_watchpoints() const
+	{
+		return !m_read.empty() || !m_write.empty();
+	}
+
+	void on_break(break_handler handler)
+	{
+		m_handler = std::move(handler);
+	}
+
+	// Returns true if execution must stop before the instruction at the address.
+	// The next check at the same address passes, so calling cpu again resumes execution.
+	bool check_execution(std::uint32_t address)
+	{
+		if(!m_execution.test(address))
+			return false;
+
+		if(m_resume_address == address)
+		{
+			m_resume_address.reset();
+			return false;
+		}
+
+		m_resume_address = address;
+		notify(break_type::execution, address);
+		return true;
+	}
+
+	void check_access(break_type type, std::uint32_t address, std::uint32_t size)
+	{
+		const auto& bits = bitmap(type);
+		for(std::uint32_t addr = address; addr < address + size; addr += (1 << GranularityShift))
+		{
+			if(bits.test(addr))
+			{
+				notify(type, address);
+				return;
+			}
+		}
+	}
+
+private:
+	void notify(break_type type, std::uint32_t address)
+	{
+		if(m_handler)
+			m_handler({type, address});
+	}
+
+	address_bitmap<AddressBits, GranularityShift>& bitmap(break_type type)
+	{
+		return const_cast<address_bitmap<AddressBits, GranularityShift>&>(std::as_const(*this).bitmap(type));
+	}
+
+	const address_bitmap<AddressBits, GranularityShift>& bitmap(break_type type) const
+	{
+		switch(type)
+		{
+		case break_type::execution:
+			return m_execution;
+		case break_type::read:
+			return m_read;
+		case break_type::write:
+			return m_write;
+		}
+
+		throw std::invalid_argument("type");
+	}
+
+private:
+	address_bitmap<AddressBits, GranularityShift> m_execution;
+	address_bitmap<AddressBits, GranularityShift> m_read;
+	address_bitmap<AddressBits, GranularityShift> m_write;
+
+	std::optional<std::uint32_t> m_resume_address;
+	break_handler m_handler;
+};
+
+} // namespace genesis
+
+#endif // __BREAKPOINTS_HPP__
@@ -0,0 +1,167 @@
+#include "cheats.h"
+
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+
+namespace genesis
+{
+
+namespace
+{
+
+constexpr std::uint32_t rom_end = 0x3FFFFF;
+constexpr std::uint32_t ram_start = 0xE00000;
+constexpr std::uint32_t ram_end = 0xFFFFFF;
+
+[[noreturn]] void throw_invalid(std::string_view code)
+{
+	throw std::invalid_argument("invalid cheat code '" + std::string(code) + "'");
+}
+
+std::uint32_t parse_hex(std::string_view str, std::string_view code)
+{
+	std::uint32_t value = 0;
+	auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value, 16);
+	if(str.empty() || ec != std::errc() || ptr != str.data() + str.size())
+		throw_invalid(code);
+	return value;
+}
+
+} // namespace
+
+
+void cheat_list::add(std::string_view code)
+{
+	if(code.find(':') != std::string_view::npos)
+	{
+		auto patch = decode_action_replay(code);
+		if(patch.address <= rom_end)
+			m_rom_patches.push_back(patch);
+		else
+			m_ram_freezes.push_back(patch);
+	}
+	else
+	{
+		m_rom_patches.push_back(decode_game_genie(code));
+	}
+}
+
+/* Game Genie code is 8 characters from the alphabet below, each encodes 5 bits.
+ * The bits are scrambled as follows:
+ * ijklm nopIJ KLMNO PABCD EFGHd efgha bcQRS TUVWX
+ * where address is ABCDEFGH IJKLMNOP QRSTUVWX and value is abcdefgh ijklmnop
+ */
+cheat_patch decode_game_genie(std::string_view code)
+{
+	static constexpr std::string_view alphabet = "ABCDEFGHJKLMNPRSTVWXYZ0123456789";
+
+	std::string chars;
+	for(char ch : code)
+	{
+		if(ch != '-')
+			chars.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(ch))));
+	}
+
+	if(chars.size() != 8 || (code.size() == 9 && code[4] != '-') || (code.size() != 8 && code.size() != 9))
+		throw_invalid(code);
+
+	std::uint32_t address = 0;
+	std::uint32_t value = 0;
+
+	for(int i = 0; i < 8; ++i)
+	{
+		auto pos = alphabet.find(chars[i]);
+		if(pos == std::string_view::npos)
+			throw_invalid(code);
+
+		auto n = static_cast<std::uint32_t>(pos);
+		switch(i)
+		{
+		case 0:
+			value |= n << 3;
+			break;
+		case 1:
+			value |= n >> 2;
+			address |= (n & 0b11) << 14;
+			break;
+		case 2:
+			address |= n << 9;
+			break;
+		case 3:
+			address |= (n & 0xF) << 20 | (n >> 4) << 8;
+			break;
+		case 4:
+			value |= (n & 1) << 12;
+			address |= (n >> 1) << 16;
+			break;
+		case 5:
+			value |= (n & 1) << 15 | (n >> 1) << 8;
+			break;
+		case 6:
+			value |= (n >> 3) << 13;
+			address |= (n & 0b111) << 5;
+			break;
+		case 7:
+			address |= n;
+			break;
+		}
+	}
+
+	// Game Genie patches only ROM words
+	if(address > rom_end || address % 2 != 0)
+		throw_invalid(code);
+
+	return {address, static_cast<std::uint16_t>(value), 2};
+}
+
+cheat_patch decode_action_replay(std::string_view code)
+{
+	auto sep = code.find(':');
+	if(sep == std::string_view::npos)
+		throw_invalid(code);
+
+	auto address_str = code.substr(0, sep);
+	auto value_str = code.substr(sep + 1);
+	if(address_str.size() != 6 || (value_str.size() != 2 && value_str.size() != 4))
+		throw_invalid(code);
+
+	auto address = parse_hex(address_str, code);
+	auto value = parse_hex(value_str, code);
+	auto size = static_cast<std::uint8_t>(value_str.size() / 2);
+
+	const bool rom = address + size - 1 <= rom_end;
+	const bool ram = address >= ram_start && address + size - 1 <= ram_end;
+	if(!rom && !ram)
+		throw_invalid(code);
+
+	// m68k cannot access words at odd addresses
+	if(size == 2 && address % 2 != 0)
+		throw_invalid(code);
+
+	return {address, static_cast<std::uint16_t>(value), size};
+}
+
+void apply_patches(std::span<const cheat_patch> patches, std::span<std::uint8_t> memory, std::uint32_t address_mask)
+{
+	for(const auto& patch : patches)
+	{
+		std::uint32_t offset = patch.address & address_mask;
+		if(offset + patch.size > memory.size())
+			throw std::out_of_range("cheat patch address is out of memory range");
+
+		if(patch.size == 2)
+		{
+			memory[offset] = static_cast<std::uint8_t>(patch.value >> 8);
+			memory[offset + 1] = static_cast<std::uint8_t>(patch.value);
+		}
+		else
+		{
+			memory[offset] = static_cast<std::uint8_t>(patch.value);
+		}
+	}
+}
+
+} // namespace genesis
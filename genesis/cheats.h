@@ -0,0 +1,67 @@
+#ifndef __CHEATS_H__
+#define __CHEATS_H__
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+
+namespace genesis
+{
+
+// Single write of a cheat code, value is stored in big endian
+struct cheat_patch
+{
+	bool operator==(const cheat_patch&) const = default;
+
+	std::uint32_t address;
+	std::uint16_t value;
+	std::uint8_t size; // 1 or 2 bytes
+};
+
+/* Game Genie / Action Replay codes split by the way they are applied.
+ *
+ * ROM patches are applied once to the ROM buffer before the memory map is built,
+ * RAM freezes are written to RAM once per frame.
+ * So patched sessions have the same per-access cost as unpatched ones.
+ */
+class cheat_list
+{
+public:
+	// Supported formats:
+	// ABCD-EFGH   - Game Genie, patches ROM word (dash is optional)
+	// AAAAAA:VVVV - Action Replay, patches ROM if address is below $400000 or freezes RAM if address is above $E00000,
+	//               2 digits value writes a byte
+	// throws std::invalid_argument if code cannot be parsed
+	void add(std::string_view code);
+
+	bool empty() const
+	{
+		return m_rom_patches.empty() && m_ram_freezes.empty();
+	}
+
+	const std::vector<cheat_patch>& rom_patches() const
+	{
+		return m_rom_patches;
+	}
+
+	const std::vector<cheat_patch>& ram_freezes() const
+	{
+		return m_ram_freezes;
+	}
+
+private:
+	std::vector<cheat_patch> m_rom_patches;
+	std::vector<cheat_patch> m_ram_freezes;
+};
+
+cheat_patch decode_game_genie(std::string_view code);
+cheat_patch decode_action_replay(std::string_view code);
+
+// writes patches to the memory at (patch address & address_mask)
+void apply_patches(std::span<const cheat_patch> patches, std::span<std::uint8_t> memory, std::uint32_t address_mask);
+
+} // namespace genesis
+
+#endif // __CHEATS_H__
@@ -0,0 +1,555 @@
+#include "m68k_stub.h"
+
+#include <algorithm>
+#include <charconv>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+namespace genesis::gdb
+{
+
+namespace
+{
+
+// check for Ctrl-C from the debugger once per this number of cycles while running
+constexpr std::uint32_t interrupt_poll_mask = 0xFFFF;
+
+// step gives up if the instruction does not complete (e.g. STOP)
+constexpr std::uint32_t max_step_cycles = 10'000'000;
+
+// d0-d7, a0-a7, sr, pc
+constexpr int num_registers = 18;
+constexpr int sr_reg = 16;
+constexpr int pc_reg = 17;
+
+constexpr std::string_view target_xml = R"(<?xml version="1.0"?>
+<!DOCTYPE target SYSTEM "gdb-target.dtd">
+<target version="1.0">
+<architecture>m68k:68000</architecture>
+<feature name="org.gnu.gdb.m68k.core">
+<reg name="d0" bitsize="32"/>
+<reg name="d1" bitsize="32"/>
+<reg name="d2" bitsize="32"/>
+<reg name="d3" bitsize="32"/>
+<reg name="d4" bitsize="32"/>
+<reg name="d5" bitsize="32"/>
+<reg name="d6" bitsize="32"/>
+<reg name="d7" bitsize="32"/>
+<reg name="a0" bitsize="32" type="data_ptr"/>
+<reg name="a1" bitsize="32" type="data_ptr"/>
+<reg name="a2" bitsize="32" type="data_ptr"/>
+<reg name="a3" bitsize="32" type="data_ptr"/>
+<reg name="a4" bitsize="32" type="data_ptr"/>
+<reg name="a5" bitsize="32" type="data_ptr"/>
+<reg name="fp" bitsize="32" type="data_ptr"/>
+<reg name="sp" bitsize="32" type="data_ptr"/>
+<reg name="ps" bitsize="32"/>
+<reg name="pc" bitsize="32" type="code_ptr"/>
+</feature>
+</target>
+)";
+
+std::string to_hex(std::uint32_t value, int digits)
+{
+	static constexpr char hex_digits[] = "0123456789abcdef";
+
+	std::string res(digits, '0');
+	for(int i = digits - 1; i >= 0; --i)
+	{
+		res[i] = hex_digits[value & 0xF];
+		value >>= 4;
+	}
+	return res;
+}
+
+std::optional<std::uint32_t> parse_hex(std::string_view str)
+{
+	std::uint32_t value = 0;
+	auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value, 16);
+	if(ec != std::errc() || ptr != str.data() + str.size() || str.empty())
+		return std::nullopt;
+	return value;
+}
+
+// splits "a<sep>b" into {a, b}
+std::pair<std::string_view, std::string_view> split(std::string_view str, char sep)
+{
+	auto pos = str.find(sep);
+	if(pos == std::string_view::npos)
+		return {str, {}};
+	return {str.substr(0, pos), str.substr(pos + 1)};
+}
+
+} // namespace
+
+
+m68k_stub::m68k_stub(m68k::cpu& cpu, memory::addressable& memory, std::function<void()> cycle, transport& conn)
+	: m_cpu(cpu), m_memory(memory), m_cycle(std::move(cycle)), m_conn(conn)
+{
+	m_cpu.on_break([this](const break_event& ev) {
+		if(!m_stop_event.has_value())
+			m_stop_event = ev;
+	});
+}
+
+m68k_stub::~m68k_stub()
+{
+	m_cpu.on_break(nullptr);
+}
+
+bool m68k_stub::serve()
+{
+	// debugger expects the cpu to be stopped between instructions and must see every executed instruction
+	m_cpu.suspend_idle_loop_skipping(true);
+	run_to_instruction_boundary();
+
+	bool kill = false;
+	while(auto packet = read_packet())
+	{
+		if(*packet == "k")
+		{
+			kill = true;
+			break;
+		}
+
+		if(*packet == "D")
+		{
+			send_packet("OK");
+			break;
+		}
+
+		std::string response;
+		try
+		{
+			response = handle_packet(*packet);
+		}
+		catch(const std::exception&)
+		{
+			// i.e. PC points to unmapped memory, the debugger must not shut down the emulator
+			response = "E02";
+		}
+
+		send_packet(response);
+	}
+
+	// let the machine run at full speed
+	m_cpu.clear_breakpoints();
+	m_cpu.suspend_idle_loop_skipping(false);
+	return !kill;
+}
+
+std::optional<std::string> m68k_stub::read_packet()
+{
+	while(true)
+	{
+		auto ch = m_conn.read(true);
+		if(!ch.has_value())
+			return std::nullopt;
+
+		// skip acks and interrupt requests received while stopped
+		if(*ch != '$')
+			continue;
+
+		std::string data;
+		std::uint8_t checksum = 0;
+		while((ch = m_conn.read(true)).has_value() && *ch != '#')
+		{
+			data.push_back(*ch);
+			checksum += static_cast<std::uint8_t>(*ch);
+		}
+
+		auto hi = m_conn.read(true);
+		auto lo = m_conn.read(true);
+		if(!ch.has_value() || !hi.has_value() || !lo.has_value())
+			return std::nullopt;
+
+		if(m_ack_mode)
+		{
+			bool valid = parse_hex(std::string{*hi, *lo}) == checksum;
+			m_conn.write(valid ? "+" : "-");
+			if(!valid)
+				continue;
+		}
+
+		return data;
+	}
+}
+
+void m68k_stub::send_packet(std::string_view data)
+{
+	std::string packet = "$";
+	std::uint8_t checksum = 0;
+
+	for(char ch : data)
+	{
+		if(ch == '$' || ch == '#' || ch == '}' || ch == '*')
+		{
+			packet.push_back('}');
+			checksum += '}';
+			ch ^= 0x20;
+		}
+
+		packet.push_back(ch);
+		checksum += static_cast<std::uint8_t>(ch);
+	}
+
+	packet.push_back('#');
+	packet += to_hex(checksum, 2);
+
+	// transport is reliable, so acks from the debugger are not awaited
+	m_conn.write(packet);
+}
+
+std::string m68k_stub::handle_packet(std::string_view packet)
+{
+	if(packet.empty())
+		return "";
+
+	const char cmd = packet[0];
+	const std::string_view args = packet.substr(1);
+
+	switch(cmd)
+	{
+	case '?':
+		return stop_reply();
+
+	case 'g':
+		return read_registers();
+	case 'G':
+		return write_registers(args);
+	case 'p':
+		return read_register(args);
+	case 'P':
+		return write_register(args);
+
+	case 'm':
+		return read_memory(args);
+	case 'M':
+		return write_memory(args);
+
+	case 'Z':
+	case 'z':
+		return change_breakpoint(args, cmd == 'Z');
+
+	case 'c':
+	case 's':
+		if(!args.empty())
+		{
+			auto addr = parse_hex(args);
+			if(!addr.has_value())
+				return "E01";
+			set_register(pc_reg, *addr);
+		}
+		return resume(cmd == 's');
+
+	case 'H':
+		return "OK";
+
+	case 'q':
+		if(packet.starts_with("qSupported"))
+			return "PacketSize=1000;qXfer:features:read+;QStartNoAckMode+";
+		if(packet == "qAttached")
+			return "1";
+		if(packet.starts_with("qXfer:features:read:"))
+			return read_features(packet.substr(std::string_view("qXfer:features:read:").size()));
+		return "";
+
+	case 'Q':
+		if(packet == "QStartNoAckMode")
+		{
+			m_ack_mode = false;
+			return "OK";
+		}
+		return "";
+
+	default:
+		// empty response means the packet is not supported
+		return "";
+	}
+}
+
+std::string m68k_stub::resume(bool step)
+{
+	m_stop_event.reset();
+	m_interrupted = false;
+
+	if(step)
+	{
+		std::uint32_t cycles = 0;
+
+		// breakpoint at the current instruction must not stop the step
+		while(m_cpu.is_idle() && ++cycles < max_step_cycles)
+		{
+			m_cycle();
+			if(m_stop_event.has_value() && m_stop_event->type == break_type::execution)
+				m_stop_event.reset();
+		}
+	}
+	else
+	{
+		std::uint32_t cycles = 0;
+		while(!m_stop_event.has_value())
+		{
+			m_cycle();
+			if((++cycles & interrupt_poll_mask) == 0 && interrupt_requested())
+			{
+				m_interrupted = true;
+				break;
+			}
+		}
+	}
+
+	run_to_instruction_boundary();
+	return stop_reply();
+}
+
+void m68k_stub::run_to_instruction_boundary()
+{
+	// watchpoints and interrupts may stop the machine in the middle of an instruction
+	while(!m_cpu.is_idle())
+		m_cycle();
+}
+
+bool m68k_stub::interrupt_requested()
+{
+	while(auto ch = m_conn.read(false))
+	{
+		if(*ch == '\x03')
+			return true;
+	}
+
+	return m_conn.is_closed();
+}
+
+std::string m68k_stub::stop_reply() const
+{
+	if(m_interrupted)
+		return "S02"; // SIGINT
+
+	if(m_stop_event.has_value())
+	{
+		switch(m_stop_event->type)
+		{
+		case break_type::read:
+			return "T05rwatch:" + to_hex(m_stop_event->address, 8) + ";";
+		case break_type::write:
+			return "T05watch:" + to_hex(m_stop_event->address, 8) + ";";
+		default:
+			break;
+		}
+	}
+
+	return "S05"; // SIGTRAP
+}
+
+std::string m68k_stub::read_registers()
+{
+	std::string res;
+	for(int i = 0; i < num_registers; ++i)
+		res += to_hex(get_register(i), 8);
+	return res;
+}
+
+std::string m68k_stub::write_registers(std::string_view hex)
+{
+	if(hex.size() != num_registers * 8)
+		return "E01";
+
+	for(int i = 0; i < num_registers; ++i)
+	{
+		auto value = parse_hex(hex.substr(i * 8, 8));
+		if(!value.has_value())
+			return "E01";
+		set_register(i, *value);
+	}
+
+	return "OK";
+}
+
+std::string m68k_stub::read_register(std::string_view args)
+{
+	auto reg_num = parse_hex(args);
+	if(!reg_num.has_value() || *reg_num >= num_registers)
+		return "E01";
+
+	return to_hex(get_register(*reg_num), 8);
+}
+
+std::string m68k_stub::write_register(std::string_view args)
+{
+	auto [reg, val] = split(args, '=');
+	auto reg_num = parse_hex(reg);
+	auto value = parse_hex(val);
+	if(!reg_num.has_value() || *reg_num >= num_registers || !value.has_value())
+		return "E01";
+
+	set_register(*reg_num, *value);
+	return "OK";
+}
+
+std::uint32_t m68k_stub::get_register(int reg_num)
+{
+	auto& regs = m_cpu.registers();
+
+	if(reg_num < 8)
+		return regs.D(reg_num).LW;
+	if(reg_num < 16)
+		return regs.A(reg_num - 8).LW;
+	if(reg_num == sr_reg)
+		return regs.sr();
+	return regs.PC;
+}
+
+void m68k_stub::set_register(int reg_num, std::uint32_t value)
+{
+	auto& regs = m_cpu.registers();
+
+	if(reg_num < 8)
+	{
+		regs.D(reg_num).LW = value;
+	}
+	else if(reg_num < 16)
+	{
+		regs.A(reg_num - 8).LW = value;
+	}
+	else if(reg_num == sr_reg)
+	{
+		regs.set_sr(static_cast<std::uint16_t>(value));
+	}
+	else if(regs.PC != value)
+	{
+		// prefetch queue must contain the new instruction, registers are not changed if it cannot be read
+		std::uint16_t ir = m_memory.read_word_now(value & 0xFFFFFF);
+		std::uint16_t irc = m_memory.read_word_now((value + 2) & 0xFFFFFF);
+
+		regs.PC = value;
+		regs.IRD = regs.IR = ir;
+		regs.IRC = irc;
+	}
+}
+
+std::string m68k_stub::read_memory(std::string_view args)
+{
+	auto [addr_str, len_str] = split(args, ',');
+	auto addr = parse_hex(addr_str);
+	auto len = parse_hex(len_str);
+	// length cannot exceed the address space
+	if(!addr.has_value() || !len.has_value() || *len > 0x1000000)
+		return "E01";
+
+	std::vector<std::uint8_t> data(*len);
+	try
+	{
+		// address space wraps at 24 bits
+		std::uint32_t start = *addr & 0xFFFFFF;
+		std::size_t head = std::min<std::size_t>(data.size(), 0x1000000 - start);
+
+		std::span<std::uint8_t> buffer = data;
+		m_memory.read_block(start, buffer.first(head));
+		m_memory.read_block(0, buffer.subspan(head));
+	}
+	catch(const std::exception&)
+	{
+		// address is not mapped
+		return "E02";
+	}
+
+	std::string res;
+	res.reserve(data.size() * 2);
+	for(auto byte : data)
+		res += to_hex(byte, 2);
+
+	return res;
+}
+
+std::string m68k_stub::write_memory(std::string_view args)
+{
+	auto [range, data] = split(args, ':');
+	auto [addr_str, len_str] = split(range, ',');
+	auto addr = parse_hex(addr_str);
+	auto len = parse_hex(len_str);
+	if(!addr.has_value() || !len.has_value() || data.size() != *len * 2)
+		return "E01";
+
+	try
+	{
+		for(std::uint32_t i = 0; i < *len; ++i)
+		{
+			auto byte = parse_hex(data.substr(i * 2, 2));
+			if(!byte.has_value())
+				return "E01";
+			m_memory.init_write((*addr + i) & 0xFFFFFF, static_cast<std::uint8_t>(*byte));
+		}
+	}
+	catch(const std::exception&)
+	{
+		return "E02";
+	}
+
+	return "OK";
+}
+
+std::string m68k_stub::change_breakpoint(std::string_view args, bool insert)
+{
+	auto [type_str, rest] = split(args, ',');
+	auto [addr_str, kind_str] = split(rest, ',');
+	auto addr = parse_hex(addr_str);
+	auto kind = parse_hex(kind_str);
+	if(type_str.size() != 1 || !addr.has_value() || !kind.has_value())
+		return "E01";
+
+	auto change = [&](break_type type, std::uint32_t len) {
+		for(std::uint32_t i = 0; i < std::max<std::uint32_t>(len, 1); ++i)
+		{
+			if(insert)
+				m_cpu.add_breakpoint(type, *addr + i);
+			else
+				m_cpu.remove_breakpoint(type, *addr + i);
+		}
+	};
+
+	switch(type_str[0])
+	{
+	case '0': // software breakpoint
+	case '1': // hardware breakpoint
+		change(break_type::execution, 1);
+		return "OK";
+
+	case '2':
+		change(break_type::write, *kind);
+		return "OK";
+
+	case '3':
+		change(break_type::read, *kind);
+		return "OK";
+
+	case '4':
+		change(break_type::write, *kind);
+		change(break_type::read, *kind);
+		return "OK";
+
+	default:
+		return "";
+	}
+}
+
+std::string m68k_stub::read_features(std::string_view args)
+{
+	auto [annex, range] = split(args, ':');
+	auto [offset_str, length_str] = split(range, ',');
+	auto offset = parse_hex(offset_str);
+	auto length = parse_hex(length_str);
+	if(annex != "target.xml" || !offset.has_value() || !length.has_value())
+		return "E00";
+
+	if(*offset >= target_xml.size())
+		return "l";
+
+	auto chunk = target_xml.substr(*offset, *length);
+	const bool last = *offset + chunk.size() >= target_xml.size();
+	return (last ? "l" : "m") + std::string(chunk);
+}
+
+} // namespace genesis::gdb
@@ -0,0 +1,72 @@
+#ifndef __GDB_M68K_STUB_H__
+#define __GDB_M68K_STUB_H__
+
+#include "m68k/cpu.h"
+#include "memory/addressable.h"
+#include "transport.h"
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+
+namespace genesis::gdb
+{
+
+/* GDB remote serial protocol stub for m68k.
+ *
+ * The stub runs the machine only when the debugger requests it (continue/step),
+ * breakpoints and watchpoints are built on m68k::cpu breakpoints.
+ * When the debugger detaches all breakpoints are removed, so the machine runs at full speed.
+ */
+class m68k_stub
+{
+public:
+	// cycle advances the whole machine by one master cycle
+	m68k_stub(m68k::cpu& cpu, memory::addressable& memory, std::function<void()> cycle, transport& conn);
+	~m68k_stub();
+
+	// Serve the debugger till it detaches or connection is closed.
+	// Returns false if the debugger requested to kill the machine.
+	bool serve();
+
+private:
+	std::optional<std::string> read_packet();
+	void send_packet(std::string_view data);
+
+	std::string handle_packet(std::string_view packet);
+	std::string resume(bool step);
+
+	std::string read_registers();
+	std::string write_registers(std::string_view hex);
+	std::string read_register(std::string_view args);
+	std::string write_register(std::string_view args);
+
+	std::string read_memory(std::string_view args);
+	std::string write_memory(std::string_view args);
+
+	std::string change_breakpoint(std::string_view args, bool insert);
+	std::string read_features(std::string_view args);
+
+	std::uint32_t get_register(int reg_num);
+	void set_register(int reg_num, std::uint32_t value);
+
+	void run_to_instruction_boundary();
+	bool interrupt_requested();
+	std::string stop_reply() const;
+
+private:
+	m68k::cpu& m_cpu;
+	memory::addressable& m_memory;
+	std::function<void()> m_cycle;
+	transport& m_conn;
+
+	bool m_ack_mode = true;
+	std::optional<break_event> m_stop_event;
+	bool m_interrupted = false;
+};
+
+} // namespace genesis::gdb
+
+#endif // __GDB_M68K_STUB_H__
@@ -0,0 +1,169 @@
+#include "transport.h"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+
+namespace genesis::gdb
+{
+
+namespace
+{
+
+#ifdef _WIN32
+using socket_t = SOCKET;
+constexpr socket_t invalid_socket = INVALID_SOCKET;
+
+void close_socket(socket_t s)
+{
+	closesocket(s);
+}
+
+struct winsock_init
+{
+	winsock_init()
+	{
+		WSADATA data;
+		if(WSAStartup(MAKEWORD(2, 2), &data) != 0)
+			throw std::runtime_error("cannot initialize winsock");
+	}
+
+	~winsock_init()
+	{
+		WSACleanup();
+	}
+};
+#else
+using socket_t = int;
+constexpr socket_t invalid_socket = -1;
+
+void close_socket(socket_t s)
+{
+	close(s);
+}
+#endif
+
+#ifdef MSG_NOSIGNAL
+// closed connection must not kill the process with SIGPIPE
+constexpr int send_flags = MSG_NOSIGNAL;
+#else
+constexpr int send_flags = 0;
+#endif
+
+socket_t to_socket(std::intptr_t s)
+{
+	return static_cast<socket_t>(s);
+}
+
+} // namespace
+
+
+std::unique_ptr<tcp_transport> tcp_transport::accept(std::uint16_t port)
+{
+#ifdef _WIN32
+	static winsock_init init;
+#endif
+
+	socket_t listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if(listener == invalid_socket)
+		throw std::runtime_error("cannot create socket");
+
+	int reuse = 1;
+	setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if(bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listener, 1) != 0)
+	{
+		close_socket(listener);
+		throw std::runtime_error("cannot listen on port " + std::to_string(port));
+	}
+
+	socket_t client = ::accept(listener, nullptr, nullptr);
+	close_socket(listener);
+
+	if(client == invalid_socket)
+		throw std::runtime_error("cannot accept debugger connection");
+
+	// packets are small, do not delay them
+	int no_delay = 1;
+	setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&no_delay), sizeof(no_delay));
+
+	return std::unique_ptr<tcp_transport>(new tcp_transport(static_cast<std::intptr_t>(client)));
+}
+
+tcp_transport::tcp_transport(std::intptr_t socket) : m_socket(socket)
+{
+}
+
+tcp_transport::~tcp_transport()
+{
+	close_socket(to_socket(m_socket));
+}
+
+std::optional<char> tcp_transport::read(bool wait)
+{
+	if(m_buffer_pos < m_buffer_size)
+		return m_buffer[m_buffer_pos++];
+
+	if(m_closed)
+		return std::nullopt;
+
+	socket_t s = to_socket(m_socket);
+
+	if(!wait)
+	{
+		fd_set fds;
+		FD_ZERO(&fds);
+		FD_SET(s, &fds);
+		timeval timeout{};
+
+		if(select(static_cast<int>(s + 1), &fds, nullptr, nullptr, &timeout) <= 0)
+			return std::nullopt;
+	}
+
+	auto received = recv(s, m_buffer.data(), static_cast<int>(m_buffer.size()), 0);
+	if(received <= 0)
+	{
+		m_closed = true;
+		return std::nullopt;
+	}
+
+	m_buffer_size = static_cast<std::size_t>(received);
+	m_buffer_pos = 1;
+	return m_buffer[0];
+}
+
+void tcp_transport::write(std::string_view data)
+{
+	socket_t s = to_socket(m_socket);
+
+	while(!data.empty() && !m_closed)
+	{
+		auto sent = send(s, data.data(), static_cast<int>(data.size()), send_flags);
+		if(sent <= 0)
+		{
+			m_closed = true;
+			break;
+		}
+
+		data.remove_prefix(sent);
+	}
+}
+
+} // namespace genesis::gdb
@@ -0,0 +1,58 @@
+#ifndef __GDB_TRANSPORT_H__
+#define __GDB_TRANSPORT_H__
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+
+namespace genesis::gdb
+{
+
+// Byte stream between the stub and the debugger
+class transport
+{
+public:
+	virtual ~transport() = default;
+
+	// wait = false returns immediately if there is no data,
+	// returns std::nullopt if there is no data or connection is closed
+	virtual std::optional<char> read(bool wait) = 0;
+	virtual void write(std::string_view data) = 0;
+
+	virtual bool is_closed() const = 0;
+};
+
+// Serves a single debugger connected over TCP, listens only on the loopback interface
+class tcp_transport : public transport
+{
+public:
+	// blocks till the debugger connects
+	static std::unique_ptr<tcp_transport> accept(std::uint16_t port);
+	~tcp_transport() override;
+
+	std::optional<char> read(bool wait) override;
+	void write(std::string_view data) override;
+
+	bool is_closed() const override
+	{
+		return m_closed;
+	}
+
+private:
+	explicit tcp_transport(std::intptr_t socket);
+
+private:
+	std::intptr_t m_socket;
+	bool m_closed = false;
+
+	std::array<char, 4096> m_buffer;
+	std::size_t m_buffer_size = 0;
+	std::size_t m_buffer_pos = 0;
+};
+
+} // namespace genesis::gdb
+
+#endif // __GDB_TRANSPORT_H__
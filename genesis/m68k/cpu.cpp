@@ -1,6 +1,8 @@
 #include "cpu.h"
 
 #include "impl/instruction_unit.hpp"
+#include "memory/watching_memory.h"
+#include "perf_counters.h"
 
 namespace genesis::m68k
 {
@@ -26,6 +28,10 @@ cpu::cpu(std::shared_ptr<memory::addressable> external_memory, std::shared_ptr<i
 
 	m_int_riser = std::make_unique<impl::interrupt_riser>(regs, _bus, exman);
 
+	// interrupts are re-evaluated only when IPL or IPM changes
+	_bus.on_interrupt_priority_change([this]() { m_int_riser->evaluate(); });
+	regs.on_ipm_change([this]() { m_int_riser->evaluate(); });
+
 	reset();
 }
 
@@ -41,7 +47,20 @@ void cpu::reset()
 
 void cpu::cycle()
 {
-	m_int_riser->cycle();
+	GENESIS_PERF_INC("m68k.cycles");
+
+	if(m_idle_loop && m_idle_loop->is_skipping())
+	{
+		// wait till polling is over before handling exceptions or breakpoints
+		bool should_wake = exman.is_raised_any() || m_idle_loop->is_suspended();
+		if(!should_wake || !busm.is_idle())
+		{
+			skip_idle_cycle();
+			return;
+		}
+
+		m_idle_loop->wake();
+	}
 
 	// TODO: move to instruction unit
 	// tracer->cycle();
@@ -51,10 +70,39 @@ void cpu::cycle()
 	if(exception_cycle)
 	{
 		excp_unit->cycle();
+
+		if(m_profiler)
+			m_profiler->on_exception_cycle();
+
+		if(m_idle_loop)
+			m_idle_loop->on_exception_cycle();
 	}
 	else
 	{
+		bool new_instruction = inst_unit->is_idle();
+		if(m_idle_loop)
+		{
+			if(new_instruction)
+			{
+				m_idle_loop->on_instruction_boundary(busm.is_idle() && scheduler.is_idle());
+				if(m_idle_loop->is_skipping())
+				{
+					skip_idle_cycle();
+					return;
+				}
+			}
+
+			m_idle_loop->on_instruction_cycle();
+		}
+
 		inst_unit->cycle();
+
+		if(m_profiler)
+		{
+			if(new_instruction)
+				m_profiler->on_instruction(inst_unit->current_instruction(), regs.SPC);
+			m_profiler->on_cycle();
+		}
 	}
 
 	scheduler.cycle();
@@ -72,11 +120,96 @@ void cpu::cycle()
 	// tracer->post_cycle();
 }
 
+void cpu::skip_idle_cycle()
+{
+	GENESIS_PERF_INC("m68k.idle_skipped_cycles");
+
+	if(m_profiler)
+		m_profiler->on_cycle();
+
+	m_idle_loop->skip_cycle();
+	busm.cycle();
+}
+
 bool cpu::is_idle() const
 {
 	return busm.is_idle() && scheduler.is_idle() && inst_unit->is_idle() && excp_unit->is_idle();
 }
 
+m68k::profiler& cpu::enable_profiler(m68k::profiler::histogram_type type, std::uint32_t sample_period)
+{
+	m_profiler = std::make_unique<m68k::profiler>(type, sample_period);
+	return *m_profiler;
+}
+
+void cpu::disable_profiler()
+{
+	m_profiler.reset();
+}
+
+void cpu::enable_idle_loop_skipping(impl::idle_loop_detector::side_effect_free_predicate is_side_effect_free)
+{
+	m_idle_loop.reset();
+	m_idle_loop = std::make_unique<impl::idle_loop_detector>(regs, busm, std::move(is_side_effect_free));
+	update_breakpoints();
+}
+
+void cpu::disable_idle_loop_skipping()
+{
+	if(m_idle_loop && m_idle_loop->is_skipping())
+		throw std::runtime_error("cpu::disable_idle_loop_skipping error: cannot disable while skipping");
+
+	m_idle_loop.reset();
+}
+
+void cpu::suspend_idle_loop_skipping(bool suspend)
+{
+	m_idle_loop_suspended = suspend;
+	update_breakpoints();
+}
+
+void cpu::add_breakpoint(break_type type, std::uint32_t address)
+{
+	m_breakpoints.add(type, address);
+	update_breakpoints();
+}
+
+void cpu::remove_breakpoint(break_type type, std::uint32_t address)
+{
+	m_breakpoints.remove(type, address);
+	update_breakpoints();
+}
+
+void cpu::clear_breakpoints()
+{
+	m_breakpoints.clear();
+	update_breakpoints();
+}
+
+void cpu::on_break(break_handler handler)
+{
+	m_breakpoints.on_break(std::move(handler));
+}
+
+void cpu::update_breakpoints()
+{
+	// instrument execution/memory access only while they have breakpoints
+	if(m_breakpoints.empty(break_type::execution))
+		inst_unit->set_breakpoint_check(nullptr);
+	else
+		inst_unit->set_breakpoint_check([this](std::uint32_t pc) { return m_breakpoints.check_execution(pc); });
+
+	// skipped loop does not execute instructions, so execution breakpoints inside it would never fire
+	if(m_idle_loop)
+		m_idle_loop->suspend(m_idle_loop_suspended || !m_breakpoints.empty(break_type::execution));
+
+	using watching_memory = memory::watching_memory<m68k::breakpoints>;
+	if(m_breakpoints.has_watchpoints())
+		busm.set_external_memory(std::make_shared<watching_memory>(external_memory, m_breakpoints));
+	else
+		busm.set_external_memory(external_memory);
+}
+
 void cpu::set_interrupt(std::uint8_t priority)
 {
 	// TODO: check if we support interrupts (int_dev is not null)
@@ -1,6 +1,7 @@
 #ifndef __M68K_CPU_H__
 #define __M68K_CPU_H__
 
+#include "breakpoints.hpp"
 #include "bus_access.h"
 #include "cpu_bus.hpp"
 #include "cpu_registers.hpp"
@@ -8,9 +9,11 @@
 #include "impl/bus_scheduler.h"
 #include "impl/exception_manager.h"
 #include "impl/exception_unit.hpp"
+#include "impl/idle_loop_detector.h"
 #include "impl/interrupt_riser.h"
 #include "impl/trace_riser.hpp"
 #include "interrupting_device.h"
+#include "profiler.h"
 
 #include <memory>
 
@@ -20,6 +23,9 @@ namespace genesis::m68k
 
 class instruction_unit;
 
+// one bit per word of 24-bit address space
+using breakpoints = genesis::breakpoints<24, 1>;
+
 class cpu
 {
 public:
@@ -32,6 +38,7 @@ public:
 	void cycle();
 	void reset();
 
+	// CCR evaluation might be deferred, so SR must be accessed through cpu_registers::sr/set_sr
 	cpu_registers& registers()
 	{
 		return regs;
@@ -49,6 +56,43 @@ public:
 
 	void set_interrupt(std::uint8_t priority);
 
+	// Profiler is disabled by default, enabling it resets previously collected data
+	m68k::profiler& enable_profiler(m68k::profiler::histogram_type type = m68k::profiler::histogram_type::sampled,
+									std::uint32_t sample_period = 64);
+	void disable_profiler();
+
+	// returns nullptr if profiler is disabled
+	m68k::profiler* profiler()
+	{
+		return m_profiler.get();
+	}
+
+	// Idle loop skipping is disabled by default. While cpu spins in an idle loop it only polls
+	// memory read by the loop, so the cpu may resume up to 1 loop iteration later than it should.
+	void enable_idle_loop_skipping(impl::idle_loop_detector::side_effect_free_predicate is_side_effect_free);
+	void disable_idle_loop_skipping();
+
+	bool is_skipping_idle_loop() const
+	{
+		return m_idle_loop && m_idle_loop->is_skipping();
+	}
+
+	// Idle loops are not skipped while suspended (i.e. while a debugger is attached),
+	// skipping is also suspended automatically while execution breakpoints are set
+	void suspend_idle_loop_skipping(bool suspend);
+
+	// Breakpoints are checked only while at least one of them is set.
+	// When execution breakpoint is hit cpu stays at the instruction boundary for one cycle,
+	// the instruction is executed once cycle is called again.
+	void add_breakpoint(break_type type, std::uint32_t address);
+	void remove_breakpoint(break_type type, std::uint32_t address);
+	void clear_breakpoints();
+	void on_break(break_handler handler);
+
+protected:
+	void skip_idle_cycle();
+	void update_breakpoints();
+
 protected:
 	cpu_registers regs;
 	cpu_bus _bus;
@@ -64,6 +108,12 @@ protected:
 	std::unique_ptr<m68k::exception_unit> excp_unit;
 	std::unique_ptr<impl::trace_riser> tracer;
 	std::unique_ptr<impl::interrupt_riser> m_int_riser;
+
+	std::unique_ptr<m68k::profiler> m_profiler;
+	std::unique_ptr<impl::idle_loop_detector> m_idle_loop;
+
+	m68k::breakpoints m_breakpoints;
+	bool m_idle_loop_suspended = false;
 };
 
 } // namespace genesis::m68k
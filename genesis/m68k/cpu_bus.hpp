@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <functional>
 #include <type_traits>
 
 
@@ -109,9 +110,20 @@ public:
 
 	void interrupt_priority(std::uint8_t ipl)
 	{
+		bool changed = ipl != interrupt_priority();
+
 		bus_state[bus_index(bus::IPL0)] = (ipl & 0b001) != 0;
 		bus_state[bus_index(bus::IPL1)] = (ipl & 0b010) != 0;
 		bus_state[bus_index(bus::IPL2)] = (ipl & 0b100) != 0;
+
+		if(changed && ipl_callback)
+			ipl_callback();
+	}
+
+	// callback is called every time IPL changes
+	void on_interrupt_priority_change(std::function<void()> callback)
+	{
+		ipl_callback = std::move(callback);
 	}
 
 	std::uint8_t interrupt_priority() const
@@ -136,6 +148,7 @@ private:
 	std::uint32_t addr_bus = 0;
 	std::uint16_t data_bus = 0;
 	bool bus_state[num_buses];
+	std::function<void()> ipl_callback;
 };
 
 } // namespace genesis::m68k
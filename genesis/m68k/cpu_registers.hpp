@@ -1,10 +1,12 @@
 #ifndef __M68K_CPU_REGISTERS_HPP__
 #define __M68K_CPU_REGISTERS_HPP__
 
+#include "cpu_flags.hpp"
 #include "exception.hpp"
 #include "impl/size_type.h"
 
 #include <cstdint>
+#include <functional>
 
 namespace genesis::m68k
 {
@@ -45,6 +47,25 @@ struct status_register
 	std::uint8_t TR : 1;
 };
 
+// Operations which CCR evaluation can be deferred
+enum class ccr_op : std::uint8_t
+{
+	none,
+	add,
+	sub,
+	cmp, // same as sub but does not affect X
+};
+
+// Inputs of the last operation with deferred CCR evaluation
+struct deferred_ccr
+{
+	ccr_op op = ccr_op::none;
+	size_type size;
+	std::uint32_t a;
+	std::uint32_t b;
+	std::uint32_t res;
+};
+
 static_assert(sizeof(data_register) == 4);
 static_assert(sizeof(address_register) == 4);
 static_assert(sizeof(status_register) == 2);
@@ -63,59 +84,22 @@ public:
 		IRC = IR = IRD = SIRD = 0x0;
 	}
 
+	// reg must be in range [0; 7]
 	data_register& D(int reg)
 	{
-		switch(reg)
-		{
-		case 0:
-			return D0;
-		case 1:
-			return D1;
-		case 2:
-			return D2;
-		case 3:
-			return D3;
-		case 4:
-			return D4;
-		case 5:
-			return D5;
-		case 6:
-			return D6;
-		case 7:
-			return D7;
-		default:
-			throw internal_error();
-		}
+		return this->*data_regs[reg];
 	}
 
+	// reg must be in range [0; 7], A7 is the active stack pointer
 	address_register& A(int reg)
 	{
-		switch(reg)
-		{
-		case 0:
-			return A0;
-		case 1:
-			return A1;
-		case 2:
-			return A2;
-		case 3:
-			return A3;
-		case 4:
-			return A4;
-		case 5:
-			return A5;
-		case 6:
-			return A6;
-		case 7:
-			return SP();
-		default:
-			throw internal_error();
-		}
+		// select SSP instead of USP without branching
+		return this->*addr_regs[reg + ((reg == 7) & flags.S)];
 	}
 
 	address_register& SP()
 	{
-		return flags.S ? SSP : USP;
+		return this->*addr_regs[7 + flags.S];
 	}
 
 	void inc_addr(int reg, size_type size)
@@ -132,6 +116,85 @@ public:
 		A(reg).LW -= size_in_bytes(size);
 	}
 
+	/* deferred CCR evaluation */
+
+	void defer_ccr(ccr_op op, size_type size, std::uint32_t a, std::uint32_t b, std::uint32_t res)
+	{
+		// CMP does not affect X, so X must be evaluated first
+		if(op == ccr_op::cmp && ccr.op != ccr_op::none && ccr.op != ccr_op::cmp)
+			sync_ccr();
+
+		ccr = {op, size, a, b, res};
+	}
+
+	bool ccr_deferred() const
+	{
+		return ccr.op != ccr_op::none;
+	}
+
+	ccr_op deferred_ccr_op() const
+	{
+		return ccr.op;
+	}
+
+	// evaluate deferred flags, must be called before reading/modifying CCR
+	void sync_ccr()
+	{
+		if(ccr.op == ccr_op::none)
+			return;
+
+		switch(ccr.size)
+		{
+		case size_type::BYTE:
+			eval_ccr<std::uint8_t, std::int8_t>();
+			break;
+		case size_type::WORD:
+			eval_ccr<std::uint16_t, std::int16_t>();
+			break;
+		case size_type::LONG:
+			eval_ccr<std::uint32_t, std::int32_t>();
+			break;
+		}
+
+		ccr.op = ccr_op::none;
+	}
+
+	/* CCR might be deferred, so SR must be read/written through these methods */
+
+	std::uint16_t sr()
+	{
+		sync_ccr();
+		return SR;
+	}
+
+	// CCR is overwritten, so deferred flags are discarded
+	void set_sr(std::uint16_t value)
+	{
+		const std::uint8_t ipm = flags.IPM;
+
+		ccr.op = ccr_op::none;
+		SR = value;
+
+		if(flags.IPM != ipm)
+			ipm_changed();
+	}
+
+	// IPM must be changed only through set_sr/set_ipm, so pending interrupts are re-evaluated
+	void set_ipm(std::uint8_t ipm)
+	{
+		if(flags.IPM == ipm)
+			return;
+
+		flags.IPM = ipm;
+		ipm_changed();
+	}
+
+	// callback is called every time IPM changes
+	void on_ipm_change(std::function<void()> callback)
+	{
+		ipm_callback = std::move(callback);
+	}
+
 	data_register D0, D1, D2, D3, D4, D5, D6, D7;
 	address_register A0, A1, A2, A3, A4, A5, A6;
 	address_register USP;
@@ -150,6 +213,56 @@ public:
 	std::uint16_t IR;
 	std::uint16_t IRD;
 	std::uint16_t SIRD; // contains opcode of instruction being executed
+
+private:
+	// register file is indexed through member tables, so access is a plain indexed load
+	using data_register_ptr = data_register cpu_registers::*;
+	using address_register_ptr = address_register cpu_registers::*;
+
+	static constexpr data_register_ptr data_regs[] = {
+		&cpu_registers::D0, &cpu_registers::D1, &cpu_registers::D2, &cpu_registers::D3,
+		&cpu_registers::D4, &cpu_registers::D5, &cpu_registers::D6, &cpu_registers::D7,
+	};
+
+	// A7 is either USP or SSP depending on the S flag
+	static constexpr address_register_ptr addr_regs[] = {
+		&cpu_registers::A0, &cpu_registers::A1, &cpu_registers::A2, &cpu_registers::A3, &cpu_registers::A4,
+		&cpu_registers::A5, &cpu_registers::A6, &cpu_registers::USP, &cpu_registers::SSP,
+	};
+
+	template <class U, class S>
+	void eval_ccr()
+	{
+		const U a = ccr.a;
+		const U b = ccr.b;
+		const U res = ccr.res;
+
+		if(ccr.op == ccr_op::add)
+		{
+			flags.V = cpu_flags::overflow_add<S>(a, b);
+			flags.C = cpu_flags::carry<U>(a, b);
+		}
+		else
+		{
+			flags.V = cpu_flags::overflow_sub<S>(a, b);
+			flags.C = cpu_flags::borrow<U>(a, b);
+		}
+
+		if(ccr.op != ccr_op::cmp)
+			flags.X = flags.C;
+
+		flags.N = S(res) < 0;
+		flags.Z = res == 0;
+	}
+
+	void ipm_changed()
+	{
+		if(ipm_callback)
+			ipm_callback();
+	}
+
+	deferred_ccr ccr;
+	std::function<void()> ipm_callback;
 };
 
 } // namespace genesis::m68k
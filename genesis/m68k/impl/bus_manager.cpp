@@ -34,7 +34,7 @@ std::uint8_t bus_manager::latched_byte() const
 	if(!byte_operation)
 		throw std::runtime_error("bus_manager::latched_byte error: don't have latched byte");
 
-	return external_memory->latched_byte();
+	return static_cast<std::uint8_t>(read_data);
 }
 
 std::uint16_t bus_manager::latched_word() const
@@ -43,7 +43,7 @@ std::uint16_t bus_manager::latched_word() const
 	if(byte_operation)
 		throw std::runtime_error("bus_manager::latched_word error: don't have latched word");
 
-	return external_memory->latched_word();
+	return read_data;
 }
 
 /* bus control interface */
@@ -126,6 +126,19 @@ void bus_manager::cycle()
 
 	case READ2:
 	case RMW_READ2:
+		if(external_memory->is_synchronous(bus.address()))
+		{
+			// ROM/RAM complete reading immediately, no need to go through the init/latched protocol
+			if(byte_operation)
+				read_data = external_memory->read_byte_now(bus.address());
+			else
+				read_data = external_memory->read_word_now(bus.address());
+
+			advance_state();
+			complete_read();
+			return;
+		}
+
 		if(byte_operation)
 			external_memory->init_read_byte(bus.address());
 		else
@@ -140,16 +153,18 @@ void bus_manager::cycle()
 		if(external_memory->is_idle())
 		{
 			if(byte_operation)
-				set_data_bus(external_memory->latched_byte());
+				read_data = external_memory->latched_byte();
 			else
-				set_data_bus(external_memory->latched_word());
+				read_data = external_memory->latched_word();
 
-			bus.set(bus::DTACK);
-			advance_state();
+			complete_read();
 		}
 		return;
 
 	case READ3:
+		if(m_observer && !bus_granted())
+			m_observer->on_read(address, space, byte_operation, read_data);
+
 		clear_bus();
 		set_idle();
 		return;
@@ -168,7 +183,7 @@ void bus_manager::cycle()
 		return;
 
 	case RMW_MODIFY1:
-		data_to_write = std::uint8_t(modify_cb(external_memory->latched_byte()));
+		data_to_write = std::uint8_t(modify_cb(std::uint8_t(read_data)));
 		advance_state();
 		return;
 
@@ -217,6 +232,9 @@ void bus_manager::cycle()
 
 	case WRITE3:
 	case RMW_WRITE3:
+		if(m_observer && !bus_granted())
+			m_observer->on_write(address);
+
 		clear_bus();
 		bus.set(bus::RW);
 
@@ -281,6 +299,13 @@ void bus_manager::cycle()
 	}
 }
 
+void bus_manager::complete_read()
+{
+	set_data_bus(read_data);
+	bus.set(bus::DTACK);
+	advance_state();
+}
+
 void bus_manager::advance_state()
 {
 	// should be safe
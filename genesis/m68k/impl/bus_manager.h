@@ -23,6 +23,16 @@ enum class addr_space
 	CPU,
 };
 
+// Observes bus cycles initiated by the cpu itself (not by external bus masters)
+class bus_observer
+{
+public:
+	virtual ~bus_observer() = default;
+
+	virtual void on_read(std::uint32_t address, addr_space space, bool byte_operation, std::uint16_t data) = 0;
+	virtual void on_write(std::uint32_t address) = 0;
+};
+
 // NOTE: we can optimize bus_manager by specifying single on_complete call back instance (not per operation)
 class bus_manager
 {
@@ -93,6 +103,12 @@ public:
 	void reset();
 	bool is_idle() const;
 
+	// replaced device must forward accesses to the original one, as an access may be in progress
+	void set_external_memory(std::shared_ptr<memory::addressable> memory)
+	{
+		external_memory = std::move(memory);
+	}
+
 	/* read/write interface */
 
 	template <class Callable = std::nullptr_t>
@@ -191,6 +207,12 @@ public:
 
 	std::uint8_t get_vector_number() const;
 
+	// observer is not owned by the bus_manager, pass nullptr to remove it
+	void set_observer(bus_observer* observer)
+	{
+		m_observer = observer;
+	}
+
 private:
 	void assert_idle(std::source_location loc = std::source_location::current()) const;
 
@@ -206,6 +228,7 @@ private:
 	}
 
 	void advance_state();
+	void complete_read();
 
 	void set_idle();
 	void on_idle();
@@ -243,8 +266,11 @@ private:
 	bool address_even; // TODO: do we need it?
 	addr_space space;
 	std::uint16_t data_to_write;
+	std::uint16_t read_data = 0;
 	std::uint8_t m_ipl;
 	std::optional<std::uint8_t> vector_number;
+
+	bus_observer* m_observer = nullptr;
 };
 
 }; // namespace genesis::m68k
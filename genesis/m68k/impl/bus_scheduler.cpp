@@ -23,8 +23,7 @@ bus_scheduler::bus_scheduler(m68k::cpu_registers& regs, m68k::bus_manager& busm)
 void bus_scheduler::reset()
 {
 	current_op.reset();
-	while(!queue.empty())
-		queue.pop();
+	queue.clear();
 	pq.reset();
 	curr_wait_cycles = 0;
 }
@@ -4,10 +4,10 @@
 #include "bus_manager.h"
 #include "m68k/cpu_registers.hpp"
 #include "prefetch_queue.hpp"
+#include "static_queue.hpp"
 
 #include <functional>
 #include <optional>
-#include <queue>
 #include <variant>
 
 
@@ -221,8 +221,9 @@ private:
 	m68k::bus_manager& busm;
 	m68k::prefetch_queue pq;
 
-	// TODO: replace to const size queue
-	std::queue<operation> queue;
+	// worst case is MOVEM.L with all 16 registers: 2 bus operations per register + a few trailing ones
+	static constexpr std::size_t max_queued_operations = 64;
+	static_queue<operation, max_queued_operations> queue;
 	std::optional<operation> current_op;
 	std::uint32_t data = 0;
 	int curr_wait_cycles = 0;
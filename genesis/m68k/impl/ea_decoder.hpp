@@ -6,7 +6,9 @@
 #include "m68k/cpu_registers.hpp"
 #include "size_type.h"
 
+#include <array>
 #include <cstdint>
+#include <utility>
 
 
 namespace genesis::m68k
@@ -235,7 +237,8 @@ public:
 		this->reg = reg;
 		mode = decode_mode(ea);
 
-		schedule_decoding(mode, reg, size);
+		// mode and size are resolved by a single table lookup
+		(this->*decoders[ea & 0x3F][std::size_t(size)])();
 	}
 
 	constexpr static addressing_mode decode_mode(std::uint8_t ea)
@@ -295,63 +298,60 @@ public:
 	}
 
 private:
-	void schedule_decoding(addressing_mode mode, std::uint8_t reg, size_type size)
-	{
-		switch(mode)
-		{
-		case addressing_mode::data_reg:
-			decode_data_reg(reg, size);
-			break;
-
-		case addressing_mode::addr_reg:
-			decode_addr_reg(reg, size);
-			break;
-
-		case addressing_mode::indir:
-			decode_indir(reg, size);
-			break;
-
-		case addressing_mode::postinc:
-			decode_postinc(reg, size);
-			break;
-
-		case addressing_mode::predec:
-			decode_predec(reg, size);
-			break;
-
-		case addressing_mode::disp_indir:
-			decode_disp_indir(reg, size);
-			break;
-
-		case addressing_mode::index_indir:
-			decode_index_indir(reg, size);
-			break;
-
-		case addressing_mode::abs_short:
-			decode_abs_short(size);
-			break;
-
-		case addressing_mode::abs_long:
-			decode_abs_long(size);
-			break;
-
-		case addressing_mode::disp_pc:
-			decode_disp_pc(size);
-			break;
-
-		case addressing_mode::index_pc:
-			decode_index_pc(size);
-			break;
+	using decoder = void (ea_decoder::*)();
+
+	// decoder specialised for addressing mode and size, reg is taken from the member
+	template <addressing_mode Mode, size_type Size>
+	void decode()
+	{
+		if constexpr(Mode == addressing_mode::data_reg)
+			decode_data_reg(reg, Size);
+		else if constexpr(Mode == addressing_mode::addr_reg)
+			decode_addr_reg(reg, Size);
+		else if constexpr(Mode == addressing_mode::indir)
+			decode_indir(reg, Size);
+		else if constexpr(Mode == addressing_mode::postinc)
+			decode_postinc(reg, Size);
+		else if constexpr(Mode == addressing_mode::predec)
+			decode_predec(reg, Size);
+		else if constexpr(Mode == addressing_mode::disp_indir)
+			decode_disp_indir(reg, Size);
+		else if constexpr(Mode == addressing_mode::index_indir)
+			decode_index_indir(reg, Size);
+		else if constexpr(Mode == addressing_mode::abs_short)
+			decode_abs_short(Size);
+		else if constexpr(Mode == addressing_mode::abs_long)
+			decode_abs_long(Size);
+		else if constexpr(Mode == addressing_mode::disp_pc)
+			decode_disp_pc(Size);
+		else if constexpr(Mode == addressing_mode::index_pc)
+			decode_index_pc(Size);
+		else if constexpr(Mode == addressing_mode::imm)
+			decode_imm(Size);
+		else
+			throw internal_error();
+	}
 
-		case addressing_mode::imm:
-			decode_imm(size);
-			break;
+	template <std::uint8_t EA>
+	constexpr static std::array<decoder, 3> decoders_for_ea()
+	{
+		constexpr auto mode = decode_mode(EA);
+		return {
+			&ea_decoder::decode<mode, size_type::BYTE>,
+			&ea_decoder::decode<mode, size_type::WORD>,
+			&ea_decoder::decode<mode, size_type::LONG>,
+		};
+	}
 
-		default:
-			throw internal_error();
-		}
+	template <std::size_t... EA>
+	constexpr static auto build_decoders(std::index_sequence<EA...>)
+	{
+		return std::array<std::array<decoder, 3>, sizeof...(EA)>{decoders_for_ea<EA>()...};
 	}
 
+	// [ea][size]
+	static const std::array<std::array<decoder, 3>, 64> decoders;
+
 private:
 	/* immediately decoding */
 	void decode_data_reg(std::uint8_t reg, size_type size)
@@ -563,6 +563,9 @@ private:
 };
 
 
+inline constexpr std::array<std::array<ea_decoder::decoder, 3>, 64> ea_decoder::decoders =
+	ea_decoder::build_decoders(std::make_index_sequence<64>{});
+
 constexpr enum ea_decoder::flags operator|(const enum ea_decoder::flags selfValue, const enum ea_decoder::flags inValue)
 {
 	return (enum ea_decoder::flags)(std::uint8_t(selfValue) | std::uint8_t(inValue));
@@ -71,6 +71,9 @@ private:
 		if(state != ex_state::IDLE || curr_ex != exception_type::none)
 			throw internal_error();
 
+		// exceptions push and modify SR
+		regs.sync_ccr();
+
 		accept_exception();
 		schedule_exception();
 		state = ex_state::WAITING_SCHEDULER;
@@ -252,7 +255,7 @@ private:
 		// update SR
 		regs.flags.S = 1;
 		regs.flags.TR = 0;
-		regs.flags.IPM = 7;
+		regs.set_ipm(7);
 
 		// NOTE: this behavior is not clear for me
 		// Set RESET and HALT for 10 cycles
@@ -397,7 +400,7 @@ private:
 		// update SR
 		regs.flags.S = 1;
 		regs.flags.TR = 0;
-		regs.flags.IPM = m_ipl;
+		regs.set_ipm(m_ipl);
 
 		scheduler.int_ack(m_ipl, [this](std::uint8_t vector_number) {
 			scheduler.wait(4);
@@ -0,0 +1,192 @@
+#include "idle_loop_detector.h"
+
+#include "exception.hpp"
+
+
+namespace genesis::m68k::impl
+{
+
+idle_loop_detector::idle_loop_detector(m68k::cpu_registers& regs, m68k::bus_manager& busm,
+									   side_effect_free_predicate is_side_effect_free)
+	: regs(regs), busm(busm), m_is_side_effect_free(std::move(is_side_effect_free))
+{
+	if(m_is_side_effect_free == nullptr)
+		throw std::invalid_argument("is_side_effect_free");
+
+	busm.set_observer(this);
+}
+
+idle_loop_detector::~idle_loop_detector()
+{
+	busm.set_observer(nullptr);
+}
+
+void idle_loop_detector::on_instruction_boundary(bool cpu_idle)
+{
+	const std::uint32_t pc = regs.PC;
+
+	if(m_suspended)
+	{
+		m_prev_pc = pc;
+		return;
+	}
+
+	switch(m_state)
+	{
+	case state::none:
+		// backward branch
+		if(pc <= m_prev_pc && m_prev_pc - pc <= max_loop_size && pc != m_rejected_loop)
+			start_observing(pc);
+		break;
+
+	case state::observing:
+		if(pc == m_loop_start)
+		{
+			if(!m_curr.clean)
+			{
+				m_rejected_loop = m_loop_start;
+				m_state = state::none;
+				break;
+			}
+
+			regs.sync_ccr();
+			if(cpu_idle && same_registers(regs, m_iteration_regs))
+			{
+				m_state = state::skipping;
+				m_cycles_till_poll = m_curr.cycles;
+				m_poll_index = 0;
+				m_poll_in_progress = false;
+				break;
+			}
+
+			// registers are still changing, try next iteration
+			start_observing(pc);
+		}
+		else if(pc < m_loop_start || pc - m_loop_start > max_loop_size)
+		{
+			// left the loop
+			m_state = state::none;
+		}
+		break;
+
+	case state::skipping:
+		throw internal_error("idle_loop_detector: cpu must not execute instructions while skipping");
+	}
+
+	m_prev_pc = pc;
+}
+
+void idle_loop_detector::skip_cycle()
+{
+	++m_skipped_cycles;
+
+	if(m_poll_in_progress)
+		return;
+
+	if(m_cycles_till_poll > 0)
+	{
+		--m_cycles_till_poll;
+		return;
+	}
+
+	// bus might be occupied by other bus master (i.e. DMA)
+	if(!busm.is_idle() || busm.bus_granted())
+		return;
+
+	if(m_poll_index == m_curr.reads.size())
+	{
+		// all locations are polled, wait for the next iteration
+		m_poll_index = 0;
+		m_cycles_till_poll = m_curr.cycles;
+		return;
+	}
+
+	start_poll();
+}
+
+void idle_loop_detector::wake()
+{
+	m_state = state::none;
+	m_poll_in_progress = false;
+	m_prev_pc = regs.PC;
+}
+
+void idle_loop_detector::suspend(bool suspended)
+{
+	m_suspended = suspended;
+
+	// skipping state is left by the cpu once polling is over
+	if(m_suspended && m_state == state::observing)
+		m_state = state::none;
+}
+
+void idle_loop_detector::on_read(std::uint32_t address, addr_space space, bool byte_operation, std::uint16_t data)
+{
+	if(m_state != state::observing || space == addr_space::PROGRAM)
+		return;
+
+	if(m_curr.reads.size() == max_polled_reads || !m_is_side_effect_free(address))
+	{
+		m_curr.clean = false;
+		return;
+	}
+
+	m_curr.reads.push_back({address, space, byte_operation, data});
+}
+
+void idle_loop_detector::on_write(std::uint32_t /* address */)
+{
+	if(m_state == state::observing)
+		m_curr.clean = false;
+}
+
+void idle_loop_detector::start_observing(std::uint32_t loop_start)
+{
+	m_state = state::observing;
+	m_loop_start = loop_start;
+
+	regs.sync_ccr();
+	m_iteration_regs = regs;
+
+	m_curr.reads.clear();
+	m_curr.cycles = 0;
+	m_curr.clean = true;
+}
+
+void idle_loop_detector::start_poll()
+{
+	const auto& read = m_curr.reads[m_poll_index];
+	m_poll_in_progress = true;
+
+	if(read.byte_operation)
+		busm.init_read_byte(read.address, read.space, [this]() { on_poll_complete(); });
+	else
+		busm.init_read_word(read.address, read.space, [this]() { on_poll_complete(); });
+}
+
+void idle_loop_detector::on_poll_complete()
+{
+	const auto& read = m_curr.reads[m_poll_index];
+	m_poll_in_progress = false;
+
+	std::uint16_t data = read.byte_operation ? busm.latched_byte() : busm.latched_word();
+	if(data != read.data)
+	{
+		// the loop is going to make progress
+		wake();
+		return;
+	}
+
+	++m_poll_index;
+}
+
+bool idle_loop_detector::same_registers(const m68k::cpu_registers& a, const m68k::cpu_registers& b)
+{
+	return a.D0.LW == b.D0.LW && a.D1.LW == b.D1.LW && a.D2.LW == b.D2.LW && a.D3.LW == b.D3.LW &&
+		   a.D4.LW == b.D4.LW && a.D5.LW == b.D5.LW && a.D6.LW == b.D6.LW && a.D7.LW == b.D7.LW &&
+		   a.A0.LW == b.A0.LW && a.A1.LW == b.A1.LW && a.A2.LW == b.A2.LW && a.A3.LW == b.A3.LW &&
+		   a.A4.LW == b.A4.LW && a.A5.LW == b.A5.LW && a.A6.LW == b.A6.LW && a.USP.LW == b.USP.LW &&
+		   a.SSP.LW == b.SSP.LW && a.PC == b.PC && a.SR == b.SR;
+}
+
+} // namespace genesis::m68k::impl
@@ -0,0 +1,142 @@
+#ifndef __M68K_IDLE_LOOP_DETECTOR_H__
+#define __M68K_IDLE_LOOP_DETECTOR_H__
+
+#include "bus_manager.h"
+#include "m68k/cpu_registers.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+namespace genesis::m68k::impl
+{
+
+/**
+ * Detects short backward-branch loops which only poll memory, e.g.
+ *   loop: TST.W (vblank_flag).L
+ *         BEQ.S loop
+ *
+ * A loop is considered idle if its iteration does not change registers, does not write to memory
+ * and reads only side-effect free locations.
+ * Such loop cannot make progress until an interrupt occurs or polled memory changes,
+ * so instead of executing it the cpu only re-reads polled locations once per iteration.
+ *
+ * Program space reads (instruction fetches) are not polled, code is assumed to not change while cpu is idle.
+ */
+class idle_loop_detector : public bus_observer
+{
+public:
+	// returns true if reading from the address does not have any side effects
+	using side_effect_free_predicate = std::function<bool(std::uint32_t /* address */)>;
+
+	static constexpr std::uint32_t max_loop_size = 32;   // in bytes
+	static constexpr std::size_t max_polled_reads = 4; // per iteration
+
+	idle_loop_detector(m68k::cpu_registers& regs, m68k::bus_manager& busm, side_effect_free_predicate is_side_effect_free);
+	~idle_loop_detector();
+
+	// must be called before the cpu starts executing next instruction
+	// cpu_idle must be true if all bus operations of the previous instruction are finished
+	void on_instruction_boundary(bool cpu_idle);
+
+	void on_instruction_cycle()
+	{
+		if(m_state == state::observing)
+			++m_curr.cycles;
+	}
+
+	// cancel detection as exceptions change the control flow
+	void on_exception_cycle()
+	{
+		m_state = state::none;
+		m_rejected_loop = no_loop;
+	}
+
+	bool is_skipping() const
+	{
+		return m_state == state::skipping;
+	}
+
+	// must be called instead of executing instructions while skipping
+	void skip_cycle();
+
+	// leave skipping mode, cpu continues from the beginning of the loop
+	void wake();
+
+	// suspended detector does not detect new loops, cpu must wake the detector if it is skipping
+	// used while every executed instruction has to be observed (i.e. execution breakpoints are set)
+	void suspend(bool suspended);
+
+	bool is_suspended() const
+	{
+		return m_suspended;
+	}
+
+	// cycles skipped since detector was created
+	std::uint64_t skipped_cycles() const
+	{
+		return m_skipped_cycles;
+	}
+
+	void on_read(std::uint32_t address, addr_space space, bool byte_operation, std::uint16_t data) override;
+	void on_write(std::uint32_t address) override;
+
+private:
+	static constexpr std::uint32_t no_loop = 0xFFFFFFFF;
+
+	enum class state
+	{
+		none,
+		observing,
+		skipping,
+	};
+
+	struct polled_read
+	{
+		std::uint32_t address;
+		addr_space space;
+		bool byte_operation;
+		std::uint16_t data;
+	};
+
+	struct iteration
+	{
+		std::vector<polled_read> reads;
+		std::uint32_t cycles = 0;
+		bool clean = true;
+	};
+
+	void start_observing(std::uint32_t loop_start);
+	void start_poll();
+	void on_poll_complete();
+
+	static bool same_registers(const m68k::cpu_registers& a, const m68k::cpu_registers& b);
+
+private:
+	m68k::cpu_registers& regs;
+	m68k::bus_manager& busm;
+	side_effect_free_predicate m_is_side_effect_free;
+
+	state m_state = state::none;
+	std::uint32_t m_prev_pc = 0;
+	bool m_suspended = false;
+
+	std::uint32_t m_loop_start = 0;
+	// do not observe the same loop again if it turned out to be busy
+	std::uint32_t m_rejected_loop = no_loop;
+
+	iteration m_curr;
+	m68k::cpu_registers m_iteration_regs;
+
+	// polling state
+	std::uint32_t m_cycles_till_poll = 0;
+	std::size_t m_poll_index = 0;
+	bool m_poll_in_progress = false;
+
+	std::uint64_t m_skipped_cycles = 0;
+};
+
+} // namespace genesis::m68k::impl
+
+#endif // __M68K_IDLE_LOOP_DETECTOR_H__
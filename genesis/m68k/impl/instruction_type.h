@@ -1,11 +1,17 @@
 #ifndef __M68K_INSTRUCTION_TYPE_H__
 #define __M68K_INSTRUCTION_TYPE_H__
 
+#include "exception.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
 
 namespace genesis::m68k
 {
 
-enum class inst_type
+// stored in the opcode map for every opcode, so keep it compact
+enum class inst_type : std::uint8_t
 {
 	NONE,
 	ADD,
@@ -100,6 +106,208 @@ enum class inst_type
 	STOP, // TODO: implement it
 };
 
+static constexpr const int inst_type_count = 91;
+
+[[maybe_unused]]
+static constexpr std::underlying_type_t<enum inst_type> inst_type_index(inst_type inst)
+{
+	return static_cast<std::underlying_type_t<inst_type>>(inst);
+}
+
+static_assert(inst_type_index(inst_type::STOP) + 1 == inst_type_count);
+
+[[maybe_unused]]
+static std::string_view inst_type_name(inst_type inst)
+{
+	switch(inst)
+	{
+	case inst_type::NONE:
+		return "NONE";
+	case inst_type::ADD:
+		return "ADD";
+	case inst_type::ADDI:
+		return "ADDI";
+	case inst_type::ADDQ:
+		return "ADDQ";
+	case inst_type::ADDA:
+		return "ADDA";
+	case inst_type::ADDX:
+		return "ADDX";
+	case inst_type::ANDItoCCR:
+		return "ANDItoCCR";
+	case inst_type::ANDItoSR:
+		return "ANDItoSR";
+	case inst_type::SUB:
+		return "SUB";
+	case inst_type::SUBI:
+		return "SUBI";
+	case inst_type::SUBQ:
+		return "SUBQ";
+	case inst_type::SUBA:
+		return "SUBA";
+	case inst_type::SUBX:
+		return "SUBX";
+	case inst_type::AND:
+		return "AND";
+	case inst_type::ANDI:
+		return "ANDI";
+	case inst_type::OR:
+		return "OR";
+	case inst_type::ORI:
+		return "ORI";
+	case inst_type::ORItoCCR:
+		return "ORItoCCR";
+	case inst_type::ORItoSR:
+		return "ORItoSR";
+	case inst_type::EOR:
+		return "EOR";
+	case inst_type::EORI:
+		return "EORI";
+	case inst_type::EORItoCCR:
+		return "EORItoCCR";
+	case inst_type::EORItoSR:
+		return "EORItoSR";
+	case inst_type::CMP:
+		return "CMP";
+	case inst_type::CMPI:
+		return "CMPI";
+	case inst_type::CMPM:
+		return "CMPM";
+	case inst_type::CMPA:
+		return "CMPA";
+	case inst_type::NEG:
+		return "NEG";
+	case inst_type::NEGX:
+		return "NEGX";
+	case inst_type::NOT:
+		return "NOT";
+	case inst_type::NOP:
+		return "NOP";
+	case inst_type::MOVEB:
+		return "MOVEB";
+	case inst_type::MOVE:
+		return "MOVE";
+	case inst_type::MOVEQ:
+		return "MOVEQ";
+	case inst_type::MOVEA:
+		return "MOVEA";
+	case inst_type::MOVEMtoREG:
+		return "MOVEMtoREG";
+	case inst_type::MOVEMtoMEM:
+		return "MOVEMtoMEM";
+	case inst_type::MOVEP:
+		return "MOVEP";
+	case inst_type::MOVEfromSR:
+		return "MOVEfromSR";
+	case inst_type::MOVEtoSR:
+		return "MOVEtoSR";
+	case inst_type::MOVE_USP:
+		return "MOVE_USP";
+	case inst_type::MOVEtoCCR:
+		return "MOVEtoCCR";
+	case inst_type::ASLRreg:
+		return "ASLRreg";
+	case inst_type::ASLRmem:
+		return "ASLRmem";
+	case inst_type::ROLRreg:
+		return "ROLRreg";
+	case inst_type::ROLRmem:
+		return "ROLRmem";
+	case inst_type::LSLRreg:
+		return "LSLRreg";
+	case inst_type::LSLRmem:
+		return "LSLRmem";
+	case inst_type::ROXLRreg:
+		return "ROXLRreg";
+	case inst_type::ROXLRmem:
+		return "ROXLRmem";
+	case inst_type::TST:
+		return "TST";
+	case inst_type::CLR:
+		return "CLR";
+	case inst_type::MULU:
+		return "MULU";
+	case inst_type::MULS:
+		return "MULS";
+	case inst_type::TRAP:
+		return "TRAP";
+	case inst_type::TRAPV:
+		return "TRAPV";
+	case inst_type::DIVU:
+		return "DIVU";
+	case inst_type::DIVS:
+		return "DIVS";
+	case inst_type::EXT:
+		return "EXT";
+	case inst_type::EXG:
+		return "EXG";
+	case inst_type::SWAP:
+		return "SWAP";
+	case inst_type::BTSTreg:
+		return "BTSTreg";
+	case inst_type::BTSTimm:
+		return "BTSTimm";
+	case inst_type::BSETreg:
+		return "BSETreg";
+	case inst_type::BSETimm:
+		return "BSETimm";
+	case inst_type::BCLRreg:
+		return "BCLRreg";
+	case inst_type::BCLRimm:
+		return "BCLRimm";
+	case inst_type::BCHGreg:
+		return "BCHGreg";
+	case inst_type::BCHGimm:
+		return "BCHGimm";
+	case inst_type::RTE:
+		return "RTE";
+	case inst_type::RTR:
+		return "RTR";
+	case inst_type::RTS:
+		return "RTS";
+	case inst_type::JMP:
+		return "JMP";
+	case inst_type::CHK:
+		return "CHK";
+	case inst_type::JSR:
+		return "JSR";
+	case inst_type::BSR:
+		return "BSR";
+	case inst_type::LEA:
+		return "LEA";
+	case inst_type::PEA:
+		return "PEA";
+	case inst_type::LINK:
+		return "LINK";
+	case inst_type::UNLK:
+		return "UNLK";
+	case inst_type::BCC:
+		return "BCC";
+	case inst_type::DBCC:
+		return "DBCC";
+	case inst_type::SCC:
+		return "SCC";
+	case inst_type::ABCDreg:
+		return "ABCDreg";
+	case inst_type::ABCDmem:
+		return "ABCDmem";
+	case inst_type::SBCDreg:
+		return "SBCDreg";
+	case inst_type::SBCDmem:
+		return "SBCDmem";
+	case inst_type::NBCD:
+		return "NBCD";
+	case inst_type::RESET:
+		return "RESET";
+	case inst_type::TAS:
+		return "TAS";
+	case inst_type::STOP:
+		return "STOP";
+	default:
+		throw genesis::internal_error();
+	}
+}
+
 } // namespace genesis::m68k
 
 #endif // __M68K_INSTRUCTION_TYPE_H__
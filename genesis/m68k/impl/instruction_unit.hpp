@@ -10,9 +10,12 @@
 #include "m68k/cpu_registers.hpp"
 #include "opcode_decoder.h"
 #include "operations.hpp"
+#include "perf_counters.h"
 #include "privilege_checker.hpp"
 #include "timings.hpp"
 
+#include <array>
+#include <functional>
 #include <iostream>
 
 
@@ -47,6 +50,11 @@ public:
 		return m_unit_state == unit_state::idle;
 	}
 
+	inst_type current_instruction() const
+	{
+		return curr_inst;
+	}
+
 	void reset()
 	{
 		m_unit_state = unit_state::idle;
@@ -55,12 +63,20 @@ public:
 		dec.reset();
 	}
 
+	// check is called with the address of every instruction before it starts executing,
+	// returning true keeps the unit idle for the current cycle
+	void set_breakpoint_check(std::function<bool(std::uint32_t)> check)
+	{
+		m_break_check = std::move(check);
+		m_prepare = m_break_check ? &instruction_unit::prepare_executing_checked : &instruction_unit::prepare_executing;
+	}
+
 	void cycle()
 	{
 		switch(m_unit_state)
 		{
 		case unit_state::idle:
-			m_exec_state = prepare_executing();
+			m_exec_state = (this->*m_prepare)();
 			if(m_exec_state == exec_state::done)
 				return;
 			m_unit_state = unit_state::executing;
@@ -82,6 +98,14 @@ public:
 	}
 
 private:
+	exec_state prepare_executing_checked()
+	{
+		if(m_break_check(regs.PC))
+			return exec_state::done;
+
+		return prepare_executing();
+	}
+
 	exec_state prepare_executing()
 	{
 		reset();
@@ -89,6 +113,12 @@ private:
 		regs.SIRD = regs.IRD;
 		regs.SPC = regs.PC;
 		curr_inst = decode_opcode(opcode);
+		m_handler = handler_for(curr_inst);
+
+		if(regs.ccr_deferred() && !ccr_can_stay_deferred(curr_inst))
+			regs.sync_ccr();
+
+		GENESIS_PERF_INC("m68k.instructions");
 
 		if(check_illegal_instruction(curr_inst, opcode))
 			return exec_state::done;
@@ -143,7 +173,14 @@ private:
 
 	exec_state execute()
 	{
-		switch(curr_inst)
+		return (this->*m_handler)();
+	}
+
+	using handler = exec_state (instruction_unit::*)();
+
+	static constexpr handler resolve_handler(inst_type inst)
+	{
+		switch(inst)
 		{
 		case inst_type::ADD:
 		case inst_type::SUB:
@@ -151,12 +188,12 @@ private:
 		case inst_type::OR:
 		case inst_type::EOR:
 		case inst_type::CMP:
-			return alu_mode_handler();
+			return &instruction_unit::alu_mode_handler;
 
 		case inst_type::ADDA:
 		case inst_type::SUBA:
 		case inst_type::CMPA:
-			return alu_address_mode_handler();
+			return &instruction_unit::alu_address_mode_handler;
 
 		case inst_type::ADDI:
 		case inst_type::ANDI:
@@ -164,183 +201,206 @@ private:
 		case inst_type::ORI:
 		case inst_type::EORI:
 		case inst_type::CMPI:
-			return alu_imm_handler();
+			return &instruction_unit::alu_imm_handler;
 
 		case inst_type::ADDQ:
 		case inst_type::SUBQ:
-			return alu_quick_handler();
+			return &instruction_unit::alu_quick_handler;
 
 		case inst_type::CMPM:
-			return rm_postinc_handler();
+			return &instruction_unit::rm_postinc_handler;
 
 		case inst_type::NEG:
 		case inst_type::NEGX:
 		case inst_type::NOT:
 		case inst_type::CLR:
 		case inst_type::NBCD:
-			return unary_handler();
+			return &instruction_unit::unary_handler;
 
 		case inst_type::ADDX:
 		case inst_type::SUBX:
-			return rm_predec_handler();
+			return &instruction_unit::rm_predec_handler;
 
 		case inst_type::NOP:
-			return nop_hanlder();
+			return &instruction_unit::nop_hanlder;
 
 		case inst_type::MOVE:
-			return move_handler();
+			return &instruction_unit::move_handler;
 
 		case inst_type::MOVEQ:
-			return moveq_handler();
+			return &instruction_unit::moveq_handler;
 
 		case inst_type::MOVEA:
-			return movea_handler();
+			return &instruction_unit::movea_handler;
 
 		case inst_type::MOVEMtoMEM:
 		case inst_type::MOVEMtoREG:
-			return movem_handler();
+			return &instruction_unit::movem_handler;
 
 		case inst_type::MOVEP:
-			return movep_handler();
+			return &instruction_unit::movep_handler;
 
 		case inst_type::MOVEfromSR:
-			return move_from_sr_handler();
+			return &instruction_unit::move_from_sr_handler;
 
 		case inst_type::MOVEtoSR:
-			return move_to_sr_handler();
+			return &instruction_unit::move_to_sr_handler;
 
 		case inst_type::MOVE_USP:
-			return move_usp_handler();
+			return &instruction_unit::move_usp_handler;
 
 		case inst_type::MOVEtoCCR:
-			return move_to_ccr_handler();
+			return &instruction_unit::move_to_ccr_handler;
 
 		case inst_type::ANDItoCCR:
 		case inst_type::ORItoCCR:
 		case inst_type::EORItoCCR:
-			return alu_to_ccr_handler();
+			return &instruction_unit::alu_to_ccr_handler;
 
 		case inst_type::ANDItoSR:
 		case inst_type::ORItoSR:
 		case inst_type::EORItoSR:
-			return alu_to_sr_handler();
+			return &instruction_unit::alu_to_sr_handler;
 
 		case inst_type::ASLRreg:
 		case inst_type::ROLRreg:
 		case inst_type::LSLRreg:
 		case inst_type::ROXLRreg:
-			return shift_reg_handler();
+			return &instruction_unit::shift_reg_handler;
 
 		case inst_type::ASLRmem:
 		case inst_type::ROLRmem:
 		case inst_type::LSLRmem:
 		case inst_type::ROXLRmem:
-			return shift_mem_handler();
+			return &instruction_unit::shift_mem_handler;
 
 		case inst_type::TST:
-			return tst_handler();
+			return &instruction_unit::tst_handler;
 
 		case inst_type::MULU:
 		case inst_type::MULS:
-			return mul_handler();
+			return &instruction_unit::mul_handler;
 
 		case inst_type::TRAP:
-			return trap_handler();
+			return &instruction_unit::trap_handler;
 
 		case inst_type::TRAPV:
-			return trapv_handler();
+			return &instruction_unit::trapv_handler;
 
 		case inst_type::DIVU:
 		case inst_type::DIVS:
-			return div_handler();
+			return &instruction_unit::div_handler;
 
 		case inst_type::EXT:
-			return ext_handler();
+			return &instruction_unit::ext_handler;
 
 		case inst_type::EXG:
-			return exg_handler();
+			return &instruction_unit::exg_handler;
 
 		case inst_type::SWAP:
-			return swap_handler();
+			return &instruction_unit::swap_handler;
 
 		case inst_type::BTSTreg:
-			return btst_reg_handler();
+			return &instruction_unit::btst_reg_handler;
 
 		case inst_type::BTSTimm:
-			return btst_imm_handler();
+			return &instruction_unit::btst_imm_handler;
 
 		case inst_type::BSETreg:
 		case inst_type::BCLRreg:
 		case inst_type::BCHGreg:
-			return bit_reg_handler();
+			return &instruction_unit::bit_reg_handler;
 
 		case inst_type::BSETimm:
 		case inst_type::BCLRimm:
 		case inst_type::BCHGimm:
-			return bit_imm_handler();
+			return &instruction_unit::bit_imm_handler;
 
 		case inst_type::RTE:
 		case inst_type::RTR:
-			return ret_handler();
+			return &instruction_unit::ret_handler;
 
 		case inst_type::RTS:
-			return rts_handler();
+			return &instruction_unit::rts_handler;
 
 		case inst_type::JMP:
-			return jmp_handler();
+			return &instruction_unit::jmp_handler;
 
 		case inst_type::CHK:
-			return chk_handler();
+			return &instruction_unit::chk_handler;
 
 		case inst_type::JSR:
-			return jsr_handler();
+			return &instruction_unit::jsr_handler;
 
 		case inst_type::BSR:
-			return bsr_handler();
+			return &instruction_unit::bsr_handler;
 
 		case inst_type::LEA:
-			return lea_handler();
+			return &instruction_unit::lea_handler;
 
 		case inst_type::PEA:
-			return pea_handler();
+			return &instruction_unit::pea_handler;
 
 		case inst_type::LINK:
-			return link_handler();
+			return &instruction_unit::link_handler;
 
 		case inst_type::UNLK:
-			return unlk_handler();
+			return &instruction_unit::unlk_handler;
 
 		case inst_type::BCC:
-			return bcc_handler();
+			return &instruction_unit::bcc_handler;
 
 		case inst_type::DBCC:
-			return dbcc_handler();
+			return &instruction_unit::dbcc_handler;
 
 		case inst_type::SCC:
-			return scc_handler();
+			return &instruction_unit::scc_handler;
 
 		case inst_type::ABCDreg:
 		case inst_type::SBCDreg:
-			return bcd_reg_handler();
+			return &instruction_unit::bcd_reg_handler;
 
 		case inst_type::ABCDmem:
 		case inst_type::SBCDmem:
-			return bcd_mem_handler();
+			return &instruction_unit::bcd_mem_handler;
 
 		case inst_type::RESET:
-			return reset_handler();
+			return &instruction_unit::reset_handler;
 
 		case inst_type::TAS:
-			return tas_handler();
+			return &instruction_unit::tas_handler;
 
 		case inst_type::STOP:
-			throw not_implemented();
+			return &instruction_unit::not_implemented_handler;
 
 		default:
-			throw internal_error("Unknown instruction: " + std::to_string((int)curr_inst));
+			return &instruction_unit::unknown_handler;
 		}
 	}
 
+	// handler is resolved once per instruction instead of on every execute() call
+	static handler handler_for(inst_type inst)
+	{
+		static constexpr auto handlers = []() {
+			std::array<handler, inst_type_count> res;
+			for(int i = 0; i < inst_type_count; ++i)
+				res[i] = resolve_handler(static_cast<inst_type>(i));
+			return res;
+		}();
+
+		return handlers[inst_type_index(inst)];
+	}
+
+	exec_state not_implemented_handler()
+	{
+		throw not_implemented();
+	}
+
+	exec_state unknown_handler()
+	{
+		throw internal_error("Unknown instruction: " + std::to_string((int)curr_inst));
+	}
+
 	exec_state alu_mode_handler()
 	{
 		switch(exec_stage++)
@@ -359,13 +419,13 @@ private:
 			bool save_to_register = !bit_is_set(opcode, 8);
 			if(save_to_register)
 			{
-				res = operations::alu(curr_inst, reg, op, size, regs.flags);
+				res = operations::alu_deferred(curr_inst, reg, op, size, regs);
 				store(reg, size, res);
 				scheduler.prefetch_one();
 			}
 			else
 			{
-				res = operations::alu(curr_inst, op, reg, size, regs.flags);
+				res = operations::alu_deferred(curr_inst, op, reg, size, regs);
 				schedule_prefetch_and_write(op, res, size);
 			}
 
@@ -392,7 +452,7 @@ private:
 			auto& reg = regs.A((opcode >> 9) & 0x7);
 			auto op = dec.result();
 
-			reg.LW = operations::alu(curr_inst, op, reg.LW, size, regs.flags);
+			reg.LW = operations::alu_deferred(curr_inst, op, reg.LW, size, regs);
 
 			scheduler.prefetch_one();
 			scheduler.wait(timings::alu_mode(curr_inst, op.mode(), opmode));
@@ -420,7 +480,7 @@ private:
 		case 2: {
 			auto op = dec.result();
 
-			res = operations::alu(curr_inst, op, imm, size, regs.flags);
+			res = operations::alu_deferred(curr_inst, op, imm, size, regs);
 
 			// TODO: fixme
 			if(curr_inst == inst_type::CMPI)
@@ -457,7 +517,7 @@ private:
 
 			auto op = dec.result();
 
-			res = operations::aluq(curr_inst, data, op, size, regs.flags);
+			res = operations::aluq_deferred(curr_inst, data, op, size, regs);
 
 			schedule_prefetch_and_write(op, res, size);
 
@@ -493,7 +553,7 @@ private:
 			return exec_state::wait_scheduler;
 
 		case 2:
-			operations::alu(curr_inst, data, res, size, regs.flags);
+			operations::alu_deferred(curr_inst, data, res, size, regs);
 			scheduler.prefetch_one();
 			return exec_state::done;
 
@@ -977,7 +1037,7 @@ private:
 			return exec_state::wait_scheduler;
 
 		case 1:
-			regs.SR = operations::move_to_sr(dec.result());
+			regs.set_sr(operations::move_to_sr(dec.result()));
 			scheduler.wait(timings::move_to_sr());
 			scheduler.prefetch_two();
 			return exec_state::done;
@@ -1015,7 +1075,7 @@ private:
 			return exec_state::wait_scheduler;
 
 		case 1:
-			regs.SR = operations::move_to_ccr(dec.result(), regs.SR);
+			regs.set_sr(operations::move_to_ccr(dec.result(), regs.SR));
 			scheduler.wait(timings::move_to_ccr());
 			scheduler.prefetch_two();
 			return exec_state::done;
@@ -1033,11 +1093,14 @@ private:
 			read_imm(size_type::BYTE);
 			return exec_state::wait_scheduler;
 
-		case 1:
-			operations::alu_to_ccr(curr_inst, imm & 0xFF, regs.SR);
+		case 1: {
+			std::uint16_t sr = regs.SR;
+			operations::alu_to_ccr(curr_inst, imm & 0xFF, sr);
+			regs.set_sr(sr);
 			scheduler.wait(8);
 			scheduler.prefetch_two();
 			return exec_state::done;
+		}
 
 		default:
 			throw internal_error();
@@ -1052,11 +1115,14 @@ private:
 			read_imm(size_type::WORD);
 			return exec_state::wait_scheduler;
 
-		case 1:
-			operations::alu_to_sr(curr_inst, imm, regs.SR);
+		case 1: {
+			std::uint16_t sr = regs.SR;
+			operations::alu_to_sr(curr_inst, imm, sr);
+			regs.set_sr(sr);
 			scheduler.wait(8);
 			scheduler.prefetch_two();
 			return exec_state::done;
+		}
 
 		default:
 			throw internal_error();
@@ -1393,7 +1459,7 @@ private:
 
 			regs.SSP.LW += 6;
 			// update SR after reading PC Low to generate correct func codes during reading (as S bit affectes it)
-			regs.SR = res;
+			regs.set_sr(res);
 		});
 
 		scheduler.prefetch_two();
@@ -1902,6 +1968,52 @@ private:
 		return size_type::BYTE;
 	}
 
+	// returns true if instruction neither reads nor partially modifies CCR
+	bool ccr_can_stay_deferred(inst_type inst) const
+	{
+		switch(inst)
+		{
+		// CCR is overwritten or deferred again
+		case inst_type::ADD:
+		case inst_type::ADDI:
+		case inst_type::ADDQ:
+		case inst_type::SUB:
+		case inst_type::SUBI:
+		case inst_type::SUBQ:
+		case inst_type::CMP:
+		case inst_type::CMPI:
+		case inst_type::CMPM:
+		case inst_type::CMPA:
+
+		// CCR is not affected
+		case inst_type::ADDA:
+		case inst_type::SUBA:
+		case inst_type::MOVEA:
+		case inst_type::MOVEMtoMEM:
+		case inst_type::MOVEMtoREG:
+		case inst_type::LEA:
+		case inst_type::PEA:
+		case inst_type::EXG:
+		case inst_type::LINK:
+		case inst_type::UNLK:
+		case inst_type::JMP:
+		case inst_type::JSR:
+		case inst_type::BSR:
+		case inst_type::RTS:
+		case inst_type::NOP:
+			return true;
+
+		// BRA and DBF do not test any conditions
+		case inst_type::BCC:
+			return ((opcode >> 8) & 0xF) == 0b0000;
+		case inst_type::DBCC:
+			return ((opcode >> 8) & 0xF) == 0b0001;
+
+		default:
+			return false;
+		}
+	}
+
 	static inst_type decode_opcode(std::uint16_t opcode)
 	{
 		return opcode_decoder::decode(opcode);
@@ -1979,8 +2091,13 @@ private:
 
 	std::uint16_t opcode = 0;
 	inst_type curr_inst;
+	handler m_handler = nullptr;
 	std::uint8_t exec_stage;
 
+	// swapped only while execution breakpoints are set, so there is no check otherwise
+	exec_state (instruction_unit::*m_prepare)() = &instruction_unit::prepare_executing;
+	std::function<bool(std::uint32_t)> m_break_check;
+
 	unit_state m_unit_state;
 	exec_state m_exec_state;
 
@@ -19,7 +19,8 @@ public:
 		m_raised_ipl = 0;
 	}
 
-	void cycle()
+	// must be called every time IPL or IPM changes
+	void evaluate()
 	{
 		auto ipl = m_bus.interrupt_priority();
 
@@ -97,124 +97,160 @@ class opcode_builder
 public:
 	opcode_builder() = delete;
 
-	static auto build_opcode_map()
+	// evaluated at compile time, so the map is stored in read-only data and costs nothing at startup
+	constexpr static auto build_opcode_map()
 	{
+		std::array<compiled_template, std::size(opcodes)> templates;
+		for(std::size_t i = 0; i < std::size(opcodes); ++i)
+			templates[i] = compile(opcodes[i]);
+
 		std::array<inst_type, 0xFFFF + 1> opcode_map;
 		opcode_map.fill(inst_type::NONE);
 
-		std::uint16_t opcode = 0;
-		while(true)
+		// templates are checked in order, so the first matching template wins.
+		// Enumerate only opcodes which fit the fixed bits of the template to keep compile time reasonable
+		for(const auto& inst : templates)
 		{
-			for(auto inst : opcodes)
+			const std::uint16_t free_bits = ~inst.mask;
+			std::uint16_t bits = free_bits;
+			while(true)
 			{
-				if(matches(opcode, inst))
-				{
-					opcode_map.at(opcode) = inst.inst;
+				std::uint16_t opcode = inst.value | bits;
+				if(opcode_map[opcode] == inst_type::NONE && matches(opcode, inst))
+					opcode_map[opcode] = inst.inst;
+
+				if(bits == 0)
 					break;
-				}
+				bits = (bits - 1) & free_bits;
 			}
-
-			if(opcode == 0xFFFF)
-				break;
-			++opcode;
 		}
 
 		return opcode_map;
 	}
 
 private:
-	constexpr static bool matches(std::uint16_t opcode, instruction inst)
+	// instruction template converted to bit masks, so it can be matched against opcode without tokenizing
+	struct compiled_template
+	{
+		inst_type inst = inst_type::NONE;
+
+		// bits of 0/1 tokens
+		std::uint16_t mask = 0;
+		std::uint16_t value = 0;
+
+		bool has_size = false;
+		std::uint8_t size_pos = 0;
+
+		std::uint8_t num_ea = 0;
+		std::array<std::uint8_t, 2> ea_pos = {};
+		std::array<std::uint64_t, 2> supported_ea = {}; // bit per every possible ea value
+
+		// destination ea in move instruction has swapped mode/register bit fields
+		bool swapped_dest_ea = false;
+	};
+
+	constexpr static compiled_template compile(instruction inst)
 	{
-		bool first_ea_mode = true;
+		compiled_template res;
+		res.inst = inst.inst;
+		res.swapped_dest_ea = inst.inst == inst_type::MOVE;
+
 		std::uint8_t pos = 0;
-		std::uint8_t size = 0xFF;
 		while(true)
 		{
 			auto token = tokenizer::next(inst.inst_template, pos);
 			if(token == token::end)
-				return true;
+				return res;
 
 			std::uint8_t bit_pos = 16 - pos;
 
 			switch(token)
 			{
 			case token::one:
-			case token::zero: {
-				std::uint8_t val = (opcode >> bit_pos) & 1;
-				if(token == token::one && val != 1)
-					return false;
-				if(token == token::zero && val != 0)
-					return false;
+			case token::zero:
+				res.mask |= 1 << bit_pos;
+				if(token == token::one)
+					res.value |= 1 << bit_pos;
 				break;
-			}
 
 			case token::any:
 				break;
 
 			case token::size:
-				if(!size_matches(opcode, bit_pos))
-					return false;
-				size = (opcode >> bit_pos) & 0b11;
+				res.has_size = true;
+				res.size_pos = bit_pos;
 				break;
 
 			case token::ea_mode: {
 				ea_modes modes;
-				if(first_ea_mode)
-				{
-					first_ea_mode = false;
+				if(res.num_ea == 0)
 					modes = inst.dst_ea_mode != ea_modes::none ? inst.dst_ea_mode : inst.src_ea_mode;
-				}
 				else
-				{
 					modes = inst.src_ea_mode;
-				}
 
-				std::uint8_t ea = (opcode >> bit_pos) & 0b111111;
-
-				if(bit_pos != 0 && inst.inst == inst_type::MOVE)
+				std::uint64_t supported = 0;
+				for(std::uint8_t ea = 0; ea < 64; ++ea)
 				{
-					// destination ea in move instruction has swapped mode/register bit fields
-					// swap it back
-					std::uint8_t mode = ea & 0x7;
-					std::uint8_t dest_reg = (ea >> 3) & 0x7;
-					ea = (mode << 3) | dest_reg;
+					if(mode_is_supported(modes, ea_decoder::decode_mode(ea)))
+						supported |= std::uint64_t(1) << ea;
 				}
 
-				if(!ea_mode_matches(ea, modes, size))
-					return false;
+				res.ea_pos[res.num_ea] = bit_pos;
+				res.supported_ea[res.num_ea] = supported;
+				++res.num_ea;
 				break;
 			}
 
 			default:
-				return false;
+				throw internal_error();
 			}
 		}
 	}
 
-	constexpr static bool size_matches(std::uint16_t value, std::uint8_t pos)
+	constexpr static bool matches(std::uint16_t opcode, const compiled_template& inst)
 	{
-		std::uint8_t size = (value >> pos) & 0b11;
-		return size != 0b11; // only 0b11 does not match
-	}
+		if((opcode & inst.mask) != inst.value)
+			return false;
 
-	static bool ea_mode_matches(std::uint8_t ea, ea_modes modes, std::uint8_t size)
-	{
-		auto ea_mode = ea_decoder::decode_mode(ea);
+		std::uint8_t size = 0xFF;
+		if(inst.has_size)
+		{
+			size = (opcode >> inst.size_pos) & 0b11;
+			if(size == 0b11)
+				return false;
+		}
 
-		// general rule, address register is not supporeted with byte size
-		if(size == 0b00 && ea_mode == addressing_mode::addr_reg)
-			return false;
+		for(std::uint8_t i = 0; i < inst.num_ea; ++i)
+		{
+			std::uint8_t ea = (opcode >> inst.ea_pos[i]) & 0b111111;
+
+			if(inst.ea_pos[i] != 0 && inst.swapped_dest_ea)
+			{
+				// swap it back
+				std::uint8_t mode = ea & 0x7;
+				std::uint8_t dest_reg = (ea >> 3) & 0x7;
+				ea = (mode << 3) | dest_reg;
+			}
+
+			if(((inst.supported_ea[i] >> ea) & 1) == 0)
+				return false;
+
+			// general rule, address register is not supporeted with byte size
+			if(size == 0b00 && ea_decoder::decode_mode(ea) == addressing_mode::addr_reg)
+				return false;
+		}
 
-		return mode_is_supported(modes, ea_mode);
+		return true;
 	}
 };
 
 
-const auto opcode_map = opcode_builder::build_opcode_map();
+constexpr auto opcode_map = opcode_builder::build_opcode_map();
 
 m68k::inst_type opcode_decoder::decode(std::uint16_t opcode)
 {
-	return opcode_map.at(opcode);
+	// map covers all possible opcodes, no need in bounds checking
+	return opcode_map[opcode];
 }
 
 } // namespace genesis::m68k
@@ -856,6 +856,64 @@ public:
 		}
 	}
 
+	// Same as alu, but ADD/SUB/CMP do not evaluate CCR, instead they defer it (see cpu_registers::sync_ccr)
+	template <class T1, class T2>
+	static std::uint32_t alu_deferred(inst_type inst, T1 a, T2 b, size_type size, cpu_registers& regs)
+	{
+		switch(inst)
+		{
+		case inst_type::ADD:
+		case inst_type::ADDI:
+			return deferred(ccr_op::add, value(a, size), value(b, size), size, regs);
+
+		case inst_type::SUB:
+		case inst_type::SUBI:
+			return deferred(ccr_op::sub, value(a, size), value(b, size), size, regs);
+
+		case inst_type::CMP:
+		case inst_type::CMPI:
+		case inst_type::CMPM:
+			deferred(ccr_op::cmp, value(a, size), value(b, size), size, regs);
+			return value(a, size);
+
+		case inst_type::CMPA: {
+			std::uint32_t dest = value(b, size_type::LONG);
+			std::uint32_t src = size == size_type::WORD ? sign_extend(value(a, size)) : value(a, size);
+			deferred(ccr_op::cmp, dest, src, size_type::LONG, regs);
+			return dest;
+		}
+
+		// do not affect CCR
+		case inst_type::ADDA:
+		case inst_type::SUBA:
+			return alu(inst, a, b, size, regs.flags);
+
+		default:
+			regs.sync_ccr();
+			return alu(inst, a, b, size, regs.flags);
+		}
+	}
+
+	template <class T1>
+	static std::uint32_t aluq_deferred(inst_type inst, T1 src, operand& dest, size_type size, cpu_registers& regs)
+	{
+		// address register is updated without affecting flags
+		if(dest.is_addr_reg())
+			return aluq(inst, src, dest, size, regs.flags);
+
+		switch(inst)
+		{
+		case inst_type::ADDQ:
+			return deferred(ccr_op::add, value(src, size), value(dest, size), size, regs);
+
+		case inst_type::SUBQ:
+			return deferred(ccr_op::sub, value(dest, size), value(src, size), size, regs);
+
+		default:
+			throw internal_error();
+		}
+	}
+
 	template <class T1>
 	static std::uint32_t alu(inst_type inst, T1 a, size_type size, status_register& sr)
 	{
@@ -1021,6 +1079,13 @@ public:
 	}
 
 private:
+	static std::uint32_t deferred(ccr_op op, std::uint32_t a, std::uint32_t b, size_type size, cpu_registers& regs)
+	{
+		std::uint32_t res = op == ccr_op::add ? add(a, b, 0, size) : sub(a, b, 0, size);
+		regs.defer_ccr(op, size, a, b, res);
+		return res;
+	}
+
 	static std::uint32_t add(std::uint32_t a, std::uint32_t b, std::uint8_t x, size_type size)
 	{
 		if(size == size_type::BYTE)
@@ -0,0 +1,151 @@
+#include "profiler.h"
+
+#include "string_utils.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+
+
+namespace genesis::m68k
+{
+
+// PC is always even, so keep only half of the address space
+constexpr std::size_t flat_histogram_size = 0x1000000 / 2;
+
+profiler::profiler(histogram_type type, std::uint32_t sample_period) : m_type(type), m_sample_period(sample_period)
+{
+	if(m_type == histogram_type::sampled && m_sample_period == 0)
+		throw std::invalid_argument("sample_period must be greater than 0");
+
+	reset();
+}
+
+std::uint64_t profiler::total_cycles() const
+{
+	std::uint64_t total = m_exception_cycles;
+	for(auto cycles : m_inst_cycles)
+		total += cycles;
+	return total;
+}
+
+std::vector<profiler::inst_stats> profiler::instructions() const
+{
+	std::vector<inst_stats> res;
+	for(int i = 0; i < inst_type_count; ++i)
+	{
+		if(m_inst_executions[i] == 0 && m_inst_cycles[i] == 0)
+			continue;
+
+		res.push_back({static_cast<inst_type>(i), m_inst_executions[i], m_inst_cycles[i]});
+	}
+
+	std::ranges::sort(res, [](const inst_stats& a, const inst_stats& b) { return a.cycles > b.cycles; });
+	return res;
+}
+
+std::vector<profiler::pc_stats> profiler::hot_pcs(std::size_t max_entries) const
+{
+	std::vector<pc_stats> res;
+
+	if(m_type == histogram_type::flat)
+	{
+		for(std::size_t i = 0; i < flat_histogram_size; ++i)
+		{
+			if(m_pc_executions[i] == 0 && m_pc_cycles[i] == 0)
+				continue;
+
+			res.push_back({static_cast<std::uint32_t>(i << 1), m_pc_executions[i], m_pc_cycles[i]});
+		}
+	}
+	else
+	{
+		res.reserve(m_pc_samples.size());
+		for(auto [pc, samples] : m_pc_samples)
+			res.push_back({pc, 0, samples * m_sample_period});
+	}
+
+	auto hotter = [](const pc_stats& a, const pc_stats& b) {
+		if(a.cycles != b.cycles)
+			return a.cycles > b.cycles;
+		return a.pc < b.pc;
+	};
+
+	if(res.size() > max_entries)
+	{
+		std::ranges::partial_sort(res, res.begin() + max_entries, hotter);
+		res.resize(max_entries);
+	}
+	else
+	{
+		std::ranges::sort(res, hotter);
+	}
+
+	return res;
+}
+
+void profiler::write_report(std::ostream& os, std::size_t max_pcs) const
+{
+	const auto total = total_cycles();
+	auto percent = [total](std::uint64_t cycles) { return total == 0 ? 0.0 : 100.0 * cycles / total; };
+
+	os << "==== M68K profile ====\n";
+	os << "Total cycles: " << total << ", exception cycles: " << m_exception_cycles << '\n';
+
+	os << "---- Instructions ----\n";
+	os << std::left << std::setw(12) << "inst" << std::right << std::setw(14) << "executions" << std::setw(16)
+	   << "cycles" << std::setw(9) << "%" << '\n';
+	for(const auto& st : instructions())
+	{
+		os << std::left << std::setw(12) << inst_type_name(st.inst) << std::right << std::setw(14) << st.executions
+		   << std::setw(16) << st.cycles << std::setw(8) << std::fixed << std::setprecision(2) << percent(st.cycles)
+		   << "%\n";
+	}
+
+	os << "---- Hot PCs" << (m_type == histogram_type::sampled ? " (sampled)" : "") << " ----\n";
+	os << std::left << std::setw(12) << "pc" << std::right << std::setw(14) << "executions" << std::setw(16)
+	   << "cycles" << std::setw(9) << "%" << '\n';
+	for(const auto& st : hot_pcs(max_pcs))
+	{
+		os << std::left << std::setw(12) << su::hex_str(st.pc, 6) << std::right << std::setw(14) << st.executions
+		   << std::setw(16) << st.cycles << std::setw(8) << std::fixed << std::setprecision(2) << percent(st.cycles)
+		   << "%\n";
+	}
+
+	os << "======================\n";
+}
+
+void profiler::write_instructions_csv(std::ostream& os) const
+{
+	os << "inst,executions,cycles\n";
+	for(const auto& st : instructions())
+		os << inst_type_name(st.inst) << ',' << st.executions << ',' << st.cycles << '\n';
+}
+
+void profiler::write_pcs_csv(std::ostream& os) const
+{
+	os << "pc,executions,cycles\n";
+	for(const auto& st : hot_pcs(flat_histogram_size))
+		os << su::hex_str(st.pc, 6) << ',' << st.executions << ',' << st.cycles << '\n';
+}
+
+void profiler::reset()
+{
+	m_sample_counter = 0;
+	m_curr_inst = inst_type_index(inst_type::NONE);
+	m_curr_pc = 0;
+
+	m_inst_executions.fill(0);
+	m_inst_cycles.fill(0);
+	m_exception_cycles = 0;
+
+	m_pc_samples.clear();
+
+	if(m_type == histogram_type::flat)
+	{
+		m_pc_executions.assign(flat_histogram_size, 0);
+		m_pc_cycles.assign(flat_histogram_size, 0);
+	}
+}
+
+} // namespace genesis::m68k
@@ -0,0 +1,130 @@
+#ifndef __M68K_PROFILER_H__
+#define __M68K_PROFILER_H__
+
+#include "impl/instruction_type.h"
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+
+namespace genesis::m68k
+{
+
+/* Collects execution statistics per instruction type and per PC.
+ *
+ * Every cycle spent by the instruction unit is attributed to the currently executing instruction,
+ * cycles spent by the exception unit are accounted separately.
+ */
+class profiler
+{
+public:
+	enum class histogram_type
+	{
+		// Exact executions/cycles for every PC of 24-bit address space (8M even addresses, takes 128MB).
+		flat,
+
+		// PC of the executing instruction is sampled every sample_period cycles.
+		// Only cycles are estimated per PC (samples * sample_period), executions are not tracked.
+		sampled,
+	};
+
+	struct inst_stats
+	{
+		inst_type inst;
+		std::uint64_t executions;
+		std::uint64_t cycles;
+	};
+
+	struct pc_stats
+	{
+		std::uint32_t pc;
+		std::uint64_t executions;
+		std::uint64_t cycles;
+	};
+
+public:
+	explicit profiler(histogram_type type = histogram_type::sampled, std::uint32_t sample_period = 64);
+
+	histogram_type type() const
+	{
+		return m_type;
+	}
+
+	void on_instruction(inst_type inst, std::uint32_t pc)
+	{
+		m_curr_inst = inst_type_index(inst);
+		m_curr_pc = pc & 0xFFFFFF;
+
+		++m_inst_executions[m_curr_inst];
+		if(m_type == histogram_type::flat)
+			++m_pc_executions[m_curr_pc >> 1];
+	}
+
+	void on_cycle()
+	{
+		++m_inst_cycles[m_curr_inst];
+
+		if(m_type == histogram_type::flat)
+		{
+			++m_pc_cycles[m_curr_pc >> 1];
+		}
+		else if(++m_sample_counter == m_sample_period)
+		{
+			m_sample_counter = 0;
+			++m_pc_samples[m_curr_pc];
+		}
+	}
+
+	void on_exception_cycle()
+	{
+		++m_exception_cycles;
+	}
+
+	std::uint64_t total_cycles() const;
+	std::uint64_t exception_cycles() const
+	{
+		return m_exception_cycles;
+	}
+
+	// executed instructions sorted by cycles (descending)
+	std::vector<inst_stats> instructions() const;
+
+	// up to max_entries hottest PCs sorted by cycles (descending)
+	std::vector<pc_stats> hot_pcs(std::size_t max_entries) const;
+
+	void write_report(std::ostream& os, std::size_t max_pcs = 32) const;
+
+	// CSV header: inst,executions,cycles
+	void write_instructions_csv(std::ostream& os) const;
+
+	// CSV header: pc,executions,cycles
+	void write_pcs_csv(std::ostream& os) const;
+
+	void reset();
+
+private:
+	histogram_type m_type;
+	std::uint32_t m_sample_period;
+	std::uint32_t m_sample_counter = 0;
+
+	std::size_t m_curr_inst = 0;
+	std::uint32_t m_curr_pc = 0;
+
+	std::array<std::uint64_t, inst_type_count> m_inst_executions;
+	std::array<std::uint64_t, inst_type_count> m_inst_cycles;
+	std::uint64_t m_exception_cycles = 0;
+
+	// flat histogram, indexed by PC / 2
+	std::vector<std::uint64_t> m_pc_executions;
+	std::vector<std::uint64_t> m_pc_cycles;
+
+	// sampled histogram
+	std::unordered_map<std::uint32_t, std::uint64_t> m_pc_samples;
+};
+
+} // namespace genesis::m68k
+
+#endif // __M68K_PROFILER_H__
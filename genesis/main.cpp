@@ -1,3 +1,5 @@
+#include "gdb/m68k_stub.h"
+#include "perf_counters.h"
 #include "rom.h"
 #include "rom_debug.hpp"
 #include "sdl/input_device.h"
@@ -7,9 +9,11 @@
 #include "string_utils.hpp"
 #include "time_utils.h"
 
+#include <charconv>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <optional>
 #include <string_view>
 
 using namespace genesis;
@@ -17,7 +21,8 @@ using namespace genesis;
 
 void print_usage(const char* prog_path)
 {
-	std::wcout << "Usage ." << std::filesystem::path::preferred_separator << prog_path << " <path to rom>\n";
+	std::wcout << "Usage ." << std::filesystem::path::preferred_separator << prog_path
+			   << " <path to rom> [--bus-trace <path to trace file>] [--gdb <port>] [--cheat <code>]...\n";
 }
 
 void print_key_layout(const std::map<int /* SDLK */, io_ports::key_type>& layout)
@@ -102,12 +107,54 @@ std::string get_rom_title(const genesis::rom& rom)
 
 int main(int args, char* argv[])
 {
-	if(args != 2)
+	if(args < 2 || args % 2 != 0)
 	{
 		print_usage(argv[0]);
 		return EXIT_FAILURE;
 	}
 
+	std::optional<memory::bus_trace_settings> bus_trace;
+	std::optional<std::uint16_t> gdb_port;
+	genesis::cheat_list cheats;
+
+	for(int i = 2; i < args; i += 2)
+	{
+		std::string_view option = argv[i];
+		if(option == "--bus-trace")
+		{
+			bus_trace = memory::bus_trace_settings{.trace_file = argv[i + 1]};
+		}
+		else if(option == "--gdb")
+		{
+			std::string_view port_str = argv[i + 1];
+			std::uint16_t port = 0;
+			auto [ptr, ec] = std::from_chars(port_str.data(), port_str.data() + port_str.size(), port);
+			if(ec != std::errc() || ptr != port_str.data() + port_str.size())
+			{
+				print_usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+			gdb_port = port;
+		}
+		else if(option == "--cheat")
+		{
+			try
+			{
+				cheats.add(argv[i + 1]);
+			}
+			catch(const std::invalid_argument& e)
+			{
+				std::cerr << e.what() << '\n';
+				return EXIT_FAILURE;
+			}
+		}
+		else
+		{
+			print_usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
 	try
 	{
 		std::string_view rom_path = argv[1];
@@ -133,11 +180,17 @@ int main(int args, char* argv[])
 
 		std::string rom_title = get_rom_title(rom);
 
-		genesis::smd smd(rom, input_device);
+		// battery saves are kept next to the ROM
+		auto sram_file = std::filesystem::path(rom_path).replace_extension(".srm");
+
+		genesis::smd smd(rom, input_device, bus_trace, cheats, sram_file);
+
+		// the debugger suspends skipping while it is attached
+		smd.enable_idle_loop_skipping();
 
 		auto displays = create_displays(smd, rom_title);
 
-		smd.vdp().on_frame_end([&]() {
+		smd.on_frame_end([&]() {
 			// measure_and_log([&]()
 			// {
 			for(auto& disp : displays)
@@ -153,6 +206,16 @@ int main(int args, char* argv[])
 			// }, "render frame");
 		});
 
+		if(gdb_port.has_value())
+		{
+			std::cout << "Waiting for debugger on port " << *gdb_port << '\n';
+			auto conn = gdb::tcp_transport::accept(*gdb_port);
+			gdb::m68k_stub stub(smd.m68k_cpu(), smd.m68k_memory(), [&smd]() { smd.cycle(); }, *conn);
+
+			if(!stub.serve())
+				return EXIT_SUCCESS;
+		}
+
 		const auto batch_cycles = 10'000'000ull;
 		auto cycle = 0ull;
 
@@ -170,6 +233,13 @@ int main(int args, char* argv[])
 				auto ns_per_cycle = dur / cycle;
 				std::cout << "ns per cycle: " << ns_per_cycle.count() << '\n';
 
+				if constexpr(perf::enabled)
+				{
+					// counters are reported per batch
+					perf::registry::instance().dump(std::cout);
+					perf::registry::instance().reset();
+				}
+
 				start = stop;
 				cycle = 0;
 
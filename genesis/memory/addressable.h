@@ -2,6 +2,8 @@
 #define __MEMORY_ADDRESSABLE_H__
 
 #include <cstdint>
+#include <span>
+#include <stdexcept>
 
 namespace genesis::memory
 {
@@ -23,6 +25,55 @@ public:
 
 	virtual std::uint8_t latched_byte() const = 0;
 	virtual std::uint16_t latched_word() const = 0;
+
+	// Returns true if reading at the address completes immediately,
+	// so read_byte_now/read_word_now can be used instead of the init/latched protocol
+	virtual bool is_synchronous(std::uint32_t /* address */) const
+	{
+		return false;
+	}
+
+	// Read data in one call, can be used only if the device completes reading immediately
+	// Synchronous devices should override these methods to bypass the init/latched protocol
+	virtual std::uint8_t read_byte_now(std::uint32_t address)
+	{
+		init_read_byte(address);
+		return latched_byte();
+	}
+
+	virtual std::uint16_t read_word_now(std::uint32_t address)
+	{
+		init_read_word(address);
+		return latched_word();
+	}
+
+	// Copy data.size() bytes starting at address in memory order, can be used only with synchronous devices
+	// Default implementation transfers byte by byte, devices backed by a buffer should override it
+	// Throws if any address is not synchronous, as accessing i.e. device ports changes their state
+	virtual void read_block(std::uint32_t address, std::span<std::uint8_t> data)
+	{
+		for(std::size_t i = 0; i < data.size(); ++i)
+		{
+			assert_synchronous(address + i);
+			data[i] = read_byte_now(address + i);
+		}
+	}
+
+	virtual void write_block(std::uint32_t address, std::span<const std::uint8_t> data)
+	{
+		for(std::size_t i = 0; i < data.size(); ++i)
+		{
+			assert_synchronous(address + i);
+			init_write(address + i, data[i]);
+		}
+	}
+
+private:
+	void assert_synchronous(std::uint32_t address) const
+	{
+		if(!is_synchronous(address))
+			throw std::runtime_error("block transfer is not supported by asynchronous device");
+	}
 };
 
 }; // namespace genesis::memory
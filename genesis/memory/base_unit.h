@@ -6,19 +6,50 @@
 #include "exception.hpp"
 #include "string_utils.hpp"
 
+#include <cassert>
 #include <cstdint>
 #include <cstring>
-#include <optional>
 #include <span>
 
 namespace genesis::memory
 {
 
+/* Bounds checking policies */
+
+struct checked_bounds
+{
+	static void check(std::uint32_t addr, std::size_t size, std::uint32_t max_address)
+	{
+		if(addr > max_address || (addr + size - 1) > max_address)
+			throw internal_error("buffer_unit check_addr error (" + su::hex_str(addr) +
+								 ") size: " + std::to_string(size));
+	}
+};
+
+struct unchecked_bounds
+{
+	static void check(std::uint32_t, std::size_t, std::uint32_t)
+	{
+	}
+};
+
+// For units which accesses are guaranteed to be in range by the memory map,
+// checks are done in debug builds only
+#ifdef NDEBUG
+using debug_checked_bounds = unchecked_bounds;
+#else
+using debug_checked_bounds = checked_bounds;
+#endif
+
+
+template <std::endian ByteOrder, class BoundsPolicy = checked_bounds>
 class base_unit : public addressable
+
 {
 protected:
-	base_unit(std::span<std::uint8_t> buffer, std::endian byte_order = std::endian::native)
-		: m_buffer(buffer), m_byte_order(byte_order)
+	static_assert(ByteOrder == std::endian::little || ByteOrder == std::endian::big);
+
+	base_unit(std::span<std::uint8_t> buffer) : m_buffer(buffer)
 	{
 		if(m_buffer.size() == 0)
 			throw genesis::internal_error();
@@ -52,28 +83,60 @@ public:
 
 	void init_read_byte(std::uint32_t address) override
 	{
-		reset();
-		m_latched_byte = read<std::uint8_t>(address);
+		m_latched_data = read<std::uint8_t>(address);
+		m_latch = latch::byte;
 	}
 
 	void init_read_word(std::uint32_t address) override
 	{
-		reset();
-		m_latched_word = read<std::uint16_t>(address);
+		m_latched_data = read<std::uint16_t>(address);
+		m_latch = latch::word;
 	}
 
+	// latch is on the hot path of every memory access, so it is checked in debug builds only
 	std::uint8_t latched_byte() const override
 	{
-		if(!m_latched_byte.has_value())
-			throw genesis::internal_error();
-		return m_latched_byte.value();
+		assert(m_latch == latch::byte);
+		return static_cast<std::uint8_t>(m_latched_data);
 	}
 
 	std::uint16_t latched_word() const override
 	{
-		if(!m_latched_word.has_value())
-			throw genesis::internal_error();
-		return m_latched_word.value();
+		assert(m_latch == latch::word);
+		return m_latched_data;
+	}
+
+	bool is_synchronous(std::uint32_t /* address */) const override
+	{
+		return true;
+	}
+
+	std::uint8_t read_byte_now(std::uint32_t address) override
+	{
+		return read<std::uint8_t>(address);
+	}
+
+	std::uint16_t read_word_now(std::uint32_t address) override
+	{
+		return read<std::uint16_t>(address);
+	}
+
+	void read_block(std::uint32_t address, std::span<std::uint8_t> data) override
+	{
+		if(data.empty())
+			return;
+
+		check_addr(address, data.size());
+		std::memcpy(data.data(), &m_buffer[address], data.size());
+	}
+
+	void write_block(std::uint32_t address, std::span<const std::uint8_t> data) override
+	{
+		if(data.empty())
+			return;
+
+		check_addr(address, data.size());
+		std::memcpy(&m_buffer[address], data.data(), data.size());
 	}
 
 	/* direct interface */
@@ -84,14 +147,10 @@ public:
 		check_addr(address, sizeof(T));
 
 		// convert to proper byte order
-		if(m_byte_order == std::endian::little)
-		{
+		if constexpr(ByteOrder == std::endian::little)
 			endian::sys_to_little(data);
-		}
-		else if(m_byte_order == std::endian::big)
-		{
+		else
 			endian::sys_to_big(data);
-		}
 
 		std::memcpy(&m_buffer[address], &data, sizeof(T));
 	}
@@ -102,14 +161,10 @@ public:
 		T data = read_raw<T>(address);
 
 		// convert to sys byte order
-		if(m_byte_order == std::endian::little)
-		{
+		if constexpr(ByteOrder == std::endian::little)
 			endian::little_to_sys(data);
-		}
-		else if(m_byte_order == std::endian::big)
-		{
+		else
 			endian::big_to_sys(data);
-		}
 
 		return data;
 	}
@@ -129,23 +184,26 @@ public:
 private:
 	void check_addr(std::uint32_t addr, size_t size)
 	{
-		if(addr > max_address() || (addr + size - 1) > max_address())
-			throw internal_error("buffer_unit check_addr error (" + su::hex_str(addr) +
-								 ") size: " + std::to_string(size));
+		BoundsPolicy::check(addr, size, max_address());
 	}
 
 	void reset()
 	{
-		m_latched_byte.reset();
-		m_latched_word.reset();
+		m_latch = latch::none;
 	}
 
 private:
 	std::span<std::uint8_t> m_buffer;
-	std::endian m_byte_order;
 
-	std::optional<std::uint8_t> m_latched_byte;
-	std::optional<std::uint16_t> m_latched_word;
+	enum class latch : std::uint8_t
+	{
+		none,
+		byte,
+		word,
+	};
+
+	std::uint16_t m_latched_data = 0;
+	latch m_latch = latch::none;
 };
 
 } // namespace genesis::memory
@@ -0,0 +1,85 @@
+#include "bus_trace.h"
+
+#include <stdexcept>
+#include <system_error>
+
+
+namespace genesis::memory
+{
+
+bus_trace_recorder::bus_trace_recorder(const bus_trace_settings& settings, const std::uint64_t& cycles)
+	: m_cycles(cycles), m_filter(settings.filter), m_path(settings.trace_file), m_chunk_records(settings.chunk_records)
+{
+	if(m_chunk_records == 0)
+		throw std::invalid_argument("chunk_records must be greater than 0");
+
+	{
+		std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+		trace_file_header header;
+		if(!file.write(reinterpret_cast<const char*>(&header), sizeof(header)))
+			throw std::runtime_error("cannot open bus trace file " + m_path.string());
+	}
+
+	map_next_chunk();
+}
+
+bus_trace_recorder::~bus_trace_recorder()
+{
+	m_file.reset();
+
+	// destructor must not throw, the file keeps zeroed records of the last chunk if it cannot be truncated
+	std::error_code ec;
+	std::filesystem::resize_file(m_path, sizeof(trace_file_header) + m_size * sizeof(trace_record), ec);
+}
+
+void bus_trace_recorder::map_next_chunk()
+{
+	// map only the new chunk, so extending the file does not get slower as the trace grows
+	const std::uint64_t offset = sizeof(trace_file_header) + m_size * sizeof(trace_record);
+
+	m_file.reset();
+	m_file = std::make_unique<mapped_file>(m_path, mapped_file::region{offset, m_chunk_records * sizeof(trace_record)});
+	m_records = m_file->data().data();
+	m_chunk_size = 0;
+}
+
+bus_trace_reader::bus_trace_reader(const std::filesystem::path& trace_file)
+	: m_file(trace_file, std::ios::binary)
+{
+	if(!m_file.is_open())
+		throw std::runtime_error("cannot open bus trace file " + trace_file.string());
+
+	trace_file_header header;
+	if(!m_file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		throw std::runtime_error("bus trace file is too small");
+
+	if(header.magic != trace_file_header::expected_magic)
+		throw std::runtime_error("not a bus trace file (unexpected magic or byte order)");
+
+	if(header.version != trace_file_header::expected_version || header.record_size != sizeof(trace_record))
+		throw std::runtime_error("unsupported bus trace file version");
+}
+
+bool bus_trace_reader::next(trace_record& record)
+{
+	return bool(m_file.read(reinterpret_cast<char*>(&record), sizeof(record)));
+}
+
+std::string_view trace_access_name(trace_access access)
+{
+	switch(access)
+	{
+	case trace_access::read_byte:
+		return "read byte";
+	case trace_access::read_word:
+		return "read word";
+	case trace_access::write_byte:
+		return "write byte";
+	case trace_access::write_word:
+		return "write word";
+	}
+
+	return "unknown";
+}
+
+} // namespace genesis::memory
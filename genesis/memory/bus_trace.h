@@ -0,0 +1,169 @@
+#ifndef __MEMORY_BUS_TRACE_H__
+#define __MEMORY_BUS_TRACE_H__
+
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+
+/*
+ * Binary bus trace.
+ *
+ * Accesses are stored as packed fixed-size records directly into the memory-mapped trace file,
+ * the file is extended by a chunk of records once the mapped part fills up.
+ * Records are stored in native byte order, use genesis_trace_decoder to print them.
+ */
+
+namespace genesis::memory
+{
+
+enum class trace_access : std::uint8_t
+{
+	read_byte,
+	read_word,
+	write_byte,
+	write_word,
+};
+
+struct trace_record
+{
+	std::uint64_t cycle;
+	std::uint32_t address;
+	std::uint16_t data;
+	std::uint8_t device_id;
+	trace_access access;
+};
+
+static_assert(sizeof(trace_record) == 16);
+static_assert(std::is_trivially_copyable_v<trace_record>);
+
+struct trace_file_header
+{
+	static constexpr std::uint32_t expected_magic = 0x54425347; // "GSBT"
+	static constexpr std::uint32_t expected_version = 1;
+
+	std::uint32_t magic = expected_magic;
+	std::uint32_t version = expected_version;
+	std::uint32_t record_size = sizeof(trace_record);
+	std::uint32_t reserved = 0;
+};
+
+static_assert(sizeof(trace_file_header) == 16);
+
+// Applied at record time, rejected accesses never reach the file
+struct trace_filter
+{
+	// record access only if (address & address_mask) == address_value
+	std::uint32_t address_mask = 0;
+	std::uint32_t address_value = 0;
+
+	// bit per trace_access
+	std::uint8_t access_mask = 0b1111;
+
+	// bit per device id, devices with id >= 64 are always recorded
+	std::uint64_t device_mask = ~std::uint64_t(0);
+
+	bool accepts(std::uint8_t device_id, trace_access access, std::uint32_t address) const
+	{
+		if((address & address_mask) != address_value)
+			return false;
+
+		if((access_mask & (1 << static_cast<std::uint8_t>(access))) == 0)
+			return false;
+
+		return device_id >= 64 || (device_mask & (std::uint64_t(1) << device_id)) != 0;
+	}
+};
+
+struct bus_trace_settings
+{
+	std::filesystem::path trace_file;
+	trace_filter filter{};
+
+	// number of records the trace file is extended by when the mapped part fills up
+	std::size_t chunk_records = 1 << 16;
+};
+
+class bus_trace_recorder
+{
+public:
+	// cycles is the clock stamped on every record, it must outlive the recorder
+	// an existing trace file is replaced, unused part of the last chunk is truncated on destruction
+	bus_trace_recorder(const bus_trace_settings& settings, const std::uint64_t& cycles);
+	~bus_trace_recorder();
+
+	bus_trace_recorder(const bus_trace_recorder&) = delete;
+	bus_trace_recorder& operator=(const bus_trace_recorder&) = delete;
+
+	std::uint64_t cycle() const
+	{
+		return m_cycles;
+	}
+
+	void record(std::uint64_t cycle, std::uint8_t device_id, trace_access access, std::uint32_t address,
+				std::uint16_t data)
+	{
+		if(!m_filter.accepts(device_id, access, address))
+			return;
+
+		if(m_chunk_size == m_chunk_records)
+			map_next_chunk();
+
+		trace_record rec{cycle, address, data, device_id, access};
+		std::memcpy(m_records + m_chunk_size * sizeof(trace_record), &rec, sizeof(rec));
+		++m_chunk_size;
+		++m_size;
+	}
+
+	void record(std::uint8_t device_id, trace_access access, std::uint32_t address, std::uint16_t data)
+	{
+		record(m_cycles, device_id, access, address, data);
+	}
+
+	// total number of accepted records
+	std::uint64_t records() const
+	{
+		return m_size;
+	}
+
+private:
+	void map_next_chunk();
+
+private:
+	const std::uint64_t& m_cycles;
+	trace_filter m_filter;
+
+	std::filesystem::path m_path;
+	std::size_t m_chunk_records;
+
+	// only the last chunk of the file is mapped
+	std::unique_ptr<mapped_file> m_file;
+	std::uint8_t* m_records = nullptr;
+	std::size_t m_chunk_size = 0;
+	std::uint64_t m_size = 0;
+};
+
+// Sequentially reads records of the trace file written by bus_trace_recorder
+class bus_trace_reader
+{
+public:
+	explicit bus_trace_reader(const std::filesystem::path& trace_file);
+
+	// returns false when there are no more records
+	bool next(trace_record& record);
+
+private:
+	std::ifstream m_file;
+};
+
+std::string_view trace_access_name(trace_access access);
+
+} // namespace genesis::memory
+
+#endif // __MEMORY_BUS_TRACE_H__
@@ -3,6 +3,9 @@
 
 #include "addressable.h"
 
+#include <bit>
+#include <optional>
+
 namespace genesis::memory
 {
 
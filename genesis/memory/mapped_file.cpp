@@ -0,0 +1,163 @@
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace genesis::memory
+{
+
+namespace
+{
+
+[[noreturn]] void throw_error(std::string_view what, const std::filesystem::path& path)
+{
+	throw std::runtime_error("failed to " + std::string(what) + " file '" + path.string() + "'");
+}
+
+} // namespace
+
+
+mapped_file::mapped_file(const std::filesystem::path& path, std::size_t size, std::uint8_t fill_value)
+{
+	if(map(path, 0, size, true))
+		std::memset(m_data, fill_value, size);
+}
+
+mapped_file::mapped_file(const std::filesystem::path& path, region reg)
+{
+	map(path, reg.offset, reg.size, false);
+}
+
+#ifdef _WIN32
+
+bool mapped_file::map(const std::filesystem::path& path, std::uint64_t offset, std::size_t size, bool truncate)
+{
+	if(size == 0)
+		throw std::invalid_argument("mapped file cannot be empty");
+
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+							  FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+		throw_error("open", path);
+
+	m_file = reinterpret_cast<std::intptr_t>(file);
+
+	LARGE_INTEGER current_size{};
+	GetFileSizeEx(file, &current_size);
+	const bool created = current_size.QuadPart == 0;
+
+	const std::uint64_t end = offset + size;
+	const std::uint64_t file_size = static_cast<std::uint64_t>(current_size.QuadPart);
+
+	LARGE_INTEGER new_size{};
+	new_size.QuadPart = static_cast<LONGLONG>(truncate ? end : std::max(end, file_size));
+	if(static_cast<std::uint64_t>(new_size.QuadPart) != file_size)
+	{
+		if(!SetFilePointerEx(file, new_size, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+		{
+			CloseHandle(file);
+			throw_error("resize", path);
+		}
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, new_size.HighPart, new_size.LowPart, nullptr);
+	if(mapping == nullptr)
+	{
+		CloseHandle(file);
+		throw_error("map", path);
+	}
+
+	m_mapping = reinterpret_cast<std::intptr_t>(mapping);
+
+	SYSTEM_INFO info{};
+	GetSystemInfo(&info);
+	const std::uint64_t view_offset = offset - offset % info.dwAllocationGranularity;
+
+	m_view_size = static_cast<std::size_t>(end - view_offset);
+	m_view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, static_cast<DWORD>(view_offset >> 32),
+						   static_cast<DWORD>(view_offset), m_view_size);
+	if(m_view == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		throw_error("map", path);
+	}
+
+	m_data = static_cast<std::uint8_t*>(m_view) + (offset - view_offset);
+	m_size = size;
+
+	return created;
+}
+
+mapped_file::~mapped_file()
+{
+	UnmapViewOfFile(m_view);
+	CloseHandle(reinterpret_cast<HANDLE>(m_mapping));
+	CloseHandle(reinterpret_cast<HANDLE>(m_file));
+}
+
+#else
+
+bool mapped_file::map(const std::filesystem::path& path, std::uint64_t offset, std::size_t size, bool truncate)
+{
+	if(size == 0)
+		throw std::invalid_argument("mapped file cannot be empty");
+
+	int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if(fd < 0)
+		throw_error("open", path);
+
+	struct stat st{};
+	fstat(fd, &st);
+	const bool created = st.st_size == 0;
+
+	const std::uint64_t end = offset + size;
+	const std::uint64_t file_size = static_cast<std::uint64_t>(st.st_size);
+	const bool resize = truncate ? file_size != end : file_size < end;
+	if(resize && ftruncate(fd, static_cast<off_t>(end)) != 0)
+	{
+		close(fd);
+		throw_error("resize", path);
+	}
+
+	const std::uint64_t page_size = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+	const std::uint64_t view_offset = offset - offset % page_size;
+
+	m_view_size = static_cast<std::size_t>(end - view_offset);
+	m_view = mmap(nullptr, m_view_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, static_cast<off_t>(view_offset));
+	if(m_view == MAP_FAILED)
+	{
+		close(fd);
+		throw_error("map", path);
+	}
+
+	m_file = fd;
+	m_data = static_cast<std::uint8_t*>(m_view) + (offset - view_offset);
+	m_size = size;
+
+	return created;
+}
+
+mapped_file::~mapped_file()
+{
+	// dirty pages are written back by the kernel after unmapping
+	munmap(m_view, m_view_size);
+	close(static_cast<int>(m_file));
+}
+
+#endif
+
+} // namespace genesis::memory
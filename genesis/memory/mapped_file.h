@@ -0,0 +1,63 @@
+#ifndef __MEMORY_MAPPED_FILE_H__
+#define __MEMORY_MAPPED_FILE_H__
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+
+namespace genesis::memory
+{
+
+/* File mapped into the address space.
+ *
+ * Writes to data() go to the OS page cache and are written back to the file by the OS,
+ * so callers do not need to flush the file on every change.
+ */
+class mapped_file
+{
+public:
+	// Creates the file filled with fill_value if it does not exist,
+	// file of a different size is truncated or extended with zeros
+	mapped_file(const std::filesystem::path& path, std::size_t size, std::uint8_t fill_value = 0xFF);
+
+	struct region
+	{
+		std::uint64_t offset;
+		std::size_t size;
+	};
+
+	// Maps [offset; offset + size) of the file, file is extended with zeros if it is shorter but never truncated
+	// Cost of mapping does not depend on the file size, so a growing file can be mapped chunk by chunk
+	mapped_file(const std::filesystem::path& path, region reg);
+
+	~mapped_file();
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	std::span<std::uint8_t> data()
+	{
+		return {m_data, m_size};
+	}
+
+private:
+	// returns true if the file is created
+	bool map(const std::filesystem::path& path, std::uint64_t offset, std::size_t size, bool truncate);
+
+private:
+	std::uint8_t* m_data = nullptr;
+	std::size_t m_size = 0;
+
+	// mapping starts at the offset aligned to the OS allocation granularity
+	void* m_view = nullptr;
+	std::size_t m_view_size = 0;
+
+	// platform handles
+	std::intptr_t m_file = -1;
+	std::intptr_t m_mapping = -1;
+};
+
+} // namespace genesis::memory
+
+#endif // __MEMORY_MAPPED_FILE_H__
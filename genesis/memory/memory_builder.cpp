@@ -1,8 +1,10 @@
 #include "memory_builder.h"
 
 #include "exception.hpp"
+#include "perf_counters.h"
 #include "string_utils.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <optional>
 #include <stdexcept>
@@ -17,6 +19,7 @@ struct addressable_device
 
 	std::uint32_t start_address;
 	std::uint32_t end_address;
+	std::uint32_t address_mask;
 };
 
 bool is_intersect(const auto& device, std::uint32_t address)
@@ -102,12 +105,64 @@ public:
 		return m_last_device.value().memory_unit.get().latched_word();
 	}
 
+	bool is_synchronous(std::uint32_t address) const override
+	{
+		auto dev = find_device(address);
+		return dev.memory_unit.get().is_synchronous(convert_address(dev, address));
+	}
+
+	std::uint8_t read_byte_now(std::uint32_t address) override
+	{
+		assert_idle();
+
+		auto dev = find_device(address);
+		m_last_device.emplace(dev);
+		return dev.memory_unit.get().read_byte_now(convert_address(dev, address));
+	}
+
+	std::uint16_t read_word_now(std::uint32_t address) override
+	{
+		assert_idle();
+
+		auto dev = find_device(address);
+		m_last_device.emplace(dev);
+		return dev.memory_unit.get().read_word_now(convert_address(dev, address));
+	}
+
+	void read_block(std::uint32_t address, std::span<std::uint8_t> data) override
+	{
+		auto read = [data](addressable& dev, std::uint32_t dev_address, std::size_t offset, std::size_t size) {
+			dev.read_block(dev_address, data.subspan(offset, size));
+		};
+
+		for_each_device_chunk(address, data.size(), read);
+	}
+
+	void write_block(std::uint32_t address, std::span<const std::uint8_t> data) override
+	{
+		auto write = [data](addressable& dev, std::uint32_t dev_address, std::size_t offset, std::size_t size) {
+			dev.write_block(dev_address, data.subspan(offset, size));
+		};
+
+		for_each_device_chunk(address, data.size(), write);
+	}
+
 	/* Composite interface */
 
 	void save_devices(std::vector<addressable_device> devices)
 	{
 		m_refs = std::move(devices);
 		m_refs.shrink_to_fit();
+
+#ifdef GENESIS_PERF_COUNTERS
+		m_lookups.clear();
+		for(const auto& dev : m_refs)
+		{
+			auto name = "memory.lookups[" + su::hex_str(dev.start_address, 6) + "-" +
+						su::hex_str(dev.end_address, 6) + "]";
+			m_lookups.push_back(&perf::registry::instance().get(name));
+		}
+#endif
 	}
 
 	void save_ptrs(std::vector<std::shared_ptr<addressable>> ptrs)
@@ -133,10 +188,16 @@ private:
 
 	addressable_device find_device(std::uint32_t address) const
 	{
-		for(auto& dev : m_refs)
+		for(std::size_t i = 0; i < m_refs.size(); ++i)
 		{
+			const auto& dev = m_refs[i];
 			if(dev.start_address <= address && address <= dev.end_address)
+			{
+#ifdef GENESIS_PERF_COUNTERS
+				m_lookups[i]->add(1);
+#endif
 				return dev;
+			}
 		}
 
 		throw std::runtime_error("cannot find addressable device serving address " + su::hex_str(address));
@@ -144,7 +205,31 @@ private:
 
 	static std::uint32_t convert_address(addressable_device dev, std::uint32_t address)
 	{
-		return address - dev.start_address;
+		return (address - dev.start_address) & dev.address_mask;
+	}
+
+	// split [address ; address + size) into chunks served by a single device
+	template <class Callable>
+	void for_each_device_chunk(std::uint32_t address, std::size_t size, Callable&& cb)
+	{
+		assert_idle();
+
+		std::size_t offset = 0;
+		while(offset < size)
+		{
+			auto dev = find_device(address);
+			auto dev_address = convert_address(dev, address);
+
+			// chunk must not cross the device border nor wrap around the address mask
+			std::size_t chunk_size = std::min<std::size_t>(size - offset, dev.end_address - address + 1);
+			chunk_size = std::min<std::size_t>(chunk_size, std::size_t(dev.address_mask) - dev_address + 1);
+
+			cb(dev.memory_unit.get(), dev_address, offset, chunk_size);
+
+			m_last_device.emplace(dev);
+			offset += chunk_size;
+			address += chunk_size;
+		}
 	}
 
 private:
@@ -155,6 +240,11 @@ private:
 	std::vector<std::unique_ptr<addressable>> m_unique_ptrs;
 
 	std::optional<addressable_device> m_last_device;
+
+#ifdef GENESIS_PERF_COUNTERS
+	// lookup counter per device, has the same order as m_refs
+	std::vector<perf::counter*> m_lookups;
+#endif
 };
 
 
@@ -167,7 +257,7 @@ std::shared_ptr<addressable> memory_builder::build()
 	devices.reserve(m_refs.size());
 
 	for(auto& dev : m_refs)
-		devices.push_back({dev.memory_unit, dev.start_address, dev.end_address});
+		devices.push_back({dev.memory_unit, dev.start_address, dev.end_address, dev.address_mask});
 
 	// Place devices with larger capacities at the beginning of the array
 	std::ranges::sort(devices, [](const addressable_device& a, const addressable_device& b) {
@@ -194,11 +284,12 @@ void memory_builder::add(addressable& device, std::uint32_t start_address)
 	add(device, start_address, start_address + device.max_address());
 }
 
-void memory_builder::add(addressable& device, std::uint32_t start_address, std::uint32_t end_address)
+void memory_builder::add(addressable& device, std::uint32_t start_address, std::uint32_t end_address,
+						 std::uint32_t address_mask)
 {
 	check_args(device, start_address, end_address);
 
-	m_refs.push_back({device, start_address, end_address});
+	m_refs.push_back({device, start_address, end_address, address_mask});
 }
 
 void memory_builder::add(std::shared_ptr<addressable> device, std::uint32_t start_address)
@@ -207,11 +298,12 @@ void memory_builder::add(std::shared_ptr<addressable> device, std::uint32_t star
 	add(device, start_address, start_address + device->max_address());
 }
 
-void memory_builder::add(std::shared_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address)
+void memory_builder::add(std::shared_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address,
+						 std::uint32_t address_mask)
 {
 	check_args(device.get(), start_address, end_address);
 
-	m_refs.push_back({*device, start_address, end_address});
+	m_refs.push_back({*device, start_address, end_address, address_mask});
 	m_shared_ptrs.push_back(std::move(device));
 }
 
@@ -223,11 +315,12 @@ void memory_builder::add(std::unique_ptr<addressable> device, std::uint32_t star
 	add(std::move(device), start_address, end_address);
 }
 
-void memory_builder::add(std::unique_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address)
+void memory_builder::add(std::unique_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address,
+						 std::uint32_t address_mask)
 {
 	check_args(device.get(), start_address, end_address);
 
-	m_refs.push_back({*device, start_address, end_address});
+	m_refs.push_back({*device, start_address, end_address, address_mask});
 	m_unique_ptrs.push_back(std::move(device));
 }
 
@@ -256,7 +349,7 @@ void memory_builder::mirror(std::uint32_t start_address, std::uint32_t end_addre
 	if(device == m_refs.end())
 		throw std::invalid_argument("cannot find device serving inital addresses");
 
-	memory_ref new_device{device->memory_unit, mirrored_start_address, mirrored_end_address};
+	memory_ref new_device{device->memory_unit, mirrored_start_address, mirrored_end_address, device->address_mask};
 	m_refs.push_back(new_device);
 }
 
@@ -19,6 +19,7 @@ private:
 		addressable& memory_unit;
 		std::uint32_t start_address;
 		std::uint32_t end_address;
+		std::uint32_t address_mask;
 	};
 
 	struct memory_shared_ptr
@@ -35,6 +36,11 @@ private:
 		std::uint32_t end_address;
 	};
 
+public:
+	// device address is calculated as (address - start_address) & address_mask,
+	// so using mask smaller than the range mirrors the device every (address_mask + 1) bytes
+	static constexpr std::uint32_t no_mask = 0xFFFFFFFF;
+
 public:
 	memory_builder() = default;
 
@@ -42,22 +48,26 @@ public:
 
 	// TODO: saving reference doesn't seem safe
 	void add(addressable& device, std::uint32_t start_address);
-	void add(addressable& device, std::uint32_t start_address, std::uint32_t end_address);
+	void add(addressable& device, std::uint32_t start_address, std::uint32_t end_address,
+			 std::uint32_t address_mask = no_mask);
 
 	void add(std::shared_ptr<addressable> device, std::uint32_t start_address);
-	void add(std::shared_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address);
+	void add(std::shared_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address,
+			 std::uint32_t address_mask = no_mask);
 
 	void add(std::unique_ptr<addressable> device, std::uint32_t start_address);
-	void add(std::unique_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address);
+	void add(std::unique_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address,
+			 std::uint32_t address_mask = no_mask);
 
 	void add_unique(std::unique_ptr<addressable> device, std::uint32_t start_address)
 	{
 		add(std::move(device), start_address);
 	}
 
-	void add_unique(std::unique_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address)
+	void add_unique(std::unique_ptr<addressable> device, std::uint32_t start_address, std::uint32_t end_address,
+					std::uint32_t address_mask = no_mask)
 	{
-		add(std::move(device), start_address, end_address);
+		add(std::move(device), start_address, end_address, address_mask);
 	}
 
 	// Mirror [start_address; end_address] on [mirrored_start_address; mirrored_end_address]
@@ -16,17 +16,18 @@ namespace genesis::memory
 
 /* Generic memory unit used to represent ROM and M68K/Z80 RAM */
 
-class memory_unit : public base_unit
+template <std::endian ByteOrder = std::endian::native, class BoundsPolicy = checked_bounds>
+class memory_unit : public base_unit<ByteOrder, BoundsPolicy>
 {
 public:
 	/* in bytes [0 ; highest_address] */
-	memory_unit(std::uint32_t highest_address, std::endian byte_order = std::endian::native)
-		: memory_unit(create_buffer(highest_address), byte_order)
+	memory_unit(std::uint32_t highest_address) : memory_unit(create_buffer(highest_address))
 	{
 	}
 
-	memory_unit(std::shared_ptr<std::vector<std::uint8_t>> buffer, std::endian byte_order = std::endian::native)
-		: base_unit(std::span<std::uint8_t>(buffer->data(), buffer->size()), byte_order), m_buffer(buffer)
+	memory_unit(std::shared_ptr<std::vector<std::uint8_t>> buffer)
+		: base_unit<ByteOrder, BoundsPolicy>(std::span<std::uint8_t>(buffer->data(), buffer->size())),
+		  m_buffer(buffer)
 	{
 	}
 
@@ -42,11 +43,11 @@ private:
 	std::shared_ptr<std::vector<std::uint8_t>> m_buffer;
 };
 
+template <std::endian ByteOrder = std::endian::native, class BoundsPolicy = checked_bounds>
 [[maybe_unused]] [[nodiscard]]
-static std::unique_ptr<memory::addressable> make_memory_unit(std::uint32_t highest_address,
-															 std::endian byte_order = std::endian::native)
+static std::unique_ptr<memory::addressable> make_memory_unit(std::uint32_t highest_address)
 {
-	return std::make_unique<memory::memory_unit>(highest_address, byte_order);
+	return std::make_unique<memory::memory_unit<ByteOrder, BoundsPolicy>>(highest_address);
 }
 
 } // namespace genesis::memory
@@ -8,10 +8,11 @@
 namespace genesis::memory
 {
 
-class read_only_memory_unit : public memory_unit
+template <std::endian ByteOrder = std::endian::native>
+class read_only_memory_unit : public memory_unit<ByteOrder>
 {
 public:
-	using memory_unit::memory_unit;
+	using memory_unit<ByteOrder>::memory_unit;
 
 	void init_write(std::uint32_t address, std::uint8_t data) override
 	{
@@ -23,6 +24,12 @@ public:
 		rise_access_violation(address, data);
 	}
 
+	void write_block(std::uint32_t address, std::span<const std::uint8_t> data) override
+	{
+		if(!data.empty())
+			rise_access_violation(address, data.front());
+	}
+
 private:
 	template <class T>
 	static void rise_access_violation(std::uint32_t address, T data)
@@ -32,11 +39,11 @@ private:
 	}
 };
 
+template <std::endian ByteOrder = std::endian::native>
 [[maybe_unused]] [[nodiscard]]
-static std::unique_ptr<memory::addressable> make_read_only_memory_unit(std::uint32_t highest_address,
-																	   std::endian byte_order = std::endian::native)
+static std::unique_ptr<memory::addressable> make_read_only_memory_unit(std::uint32_t highest_address)
 {
-	return std::make_unique<memory::read_only_memory_unit>(highest_address, byte_order);
+	return std::make_unique<memory::read_only_memory_unit<ByteOrder>>(highest_address);
 }
 
 } // namespace genesis::memory
@@ -0,0 +1,120 @@
+#ifndef __MEMORY_TRACING_MEMORY_H__
+#define __MEMORY_TRACING_MEMORY_H__
+
+#include "addressable.h"
+#include "bus_trace.h"
+
+#include <memory>
+
+
+namespace genesis::memory
+{
+
+// Records every access to the wrapped device into bus_trace_recorder.
+// Wrap a single device to trace it alone, or the memory map built by memory_builder to trace the whole bus.
+class tracing_memory : public memory::addressable
+{
+public:
+	tracing_memory(std::shared_ptr<addressable> unit, bus_trace_recorder& recorder, std::uint8_t device_id)
+		: m_unit(std::move(unit)), m_recorder(recorder), m_device_id(device_id)
+	{
+	}
+
+	std::uint32_t max_address() const override
+	{
+		return m_unit->max_address();
+	}
+
+	bool is_idle() const override
+	{
+		return m_unit->is_idle();
+	}
+
+	void init_write(std::uint32_t address, std::uint8_t data) override
+	{
+		m_recorder.record(m_device_id, trace_access::write_byte, address, data);
+		m_unit->init_write(address, data);
+	}
+
+	void init_write(std::uint32_t address, std::uint16_t data) override
+	{
+		m_recorder.record(m_device_id, trace_access::write_word, address, data);
+		m_unit->init_write(address, data);
+	}
+
+	// Read is recorded when data is latched for the first time, but with the cycle the read was initiated at
+	void init_read_byte(std::uint32_t address) override
+	{
+		m_pending_read = {m_recorder.cycle(), address, true};
+		m_unit->init_read_byte(address);
+	}
+
+	void init_read_word(std::uint32_t address) override
+	{
+		m_pending_read = {m_recorder.cycle(), address, true};
+		m_unit->init_read_word(address);
+	}
+
+	std::uint8_t latched_byte() const override
+	{
+		std::uint8_t data = m_unit->latched_byte();
+		record_pending_read(trace_access::read_byte, data);
+		return data;
+	}
+
+	std::uint16_t latched_word() const override
+	{
+		std::uint16_t data = m_unit->latched_word();
+		record_pending_read(trace_access::read_word, data);
+		return data;
+	}
+
+	bool is_synchronous(std::uint32_t address) const override
+	{
+		return m_unit->is_synchronous(address);
+	}
+
+	std::uint8_t read_byte_now(std::uint32_t address) override
+	{
+		std::uint8_t data = m_unit->read_byte_now(address);
+		m_recorder.record(m_device_id, trace_access::read_byte, address, data);
+		return data;
+	}
+
+	std::uint16_t read_word_now(std::uint32_t address) override
+	{
+		std::uint16_t data = m_unit->read_word_now(address);
+		m_recorder.record(m_device_id, trace_access::read_word, address, data);
+		return data;
+	}
+
+	// block transfers use the default byte by byte implementation, so every byte is recorded
+
+private:
+	void record_pending_read(trace_access access, std::uint16_t data) const
+	{
+		// latched data can be requested multiple times
+		if(!m_pending_read.active)
+			return;
+
+		m_recorder.record(m_pending_read.cycle, m_device_id, access, m_pending_read.address, data);
+		m_pending_read.active = false;
+	}
+
+private:
+	struct pending_read
+	{
+		std::uint64_t cycle;
+		std::uint32_t address;
+		bool active;
+	};
+
+	std::shared_ptr<addressable> m_unit;
+	bus_trace_recorder& m_recorder;
+	std::uint8_t m_device_id;
+	mutable pending_read m_pending_read{};
+};
+
+} // namespace genesis::memory
+
+#endif // __MEMORY_TRACING_MEMORY_H__
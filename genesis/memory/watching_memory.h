@@ -0,0 +1,100 @@
+#ifndef __MEMORY_WATCHING_MEMORY_H__
+#define __MEMORY_WATCHING_MEMORY_H__
+
+#include "addressable.h"
+#include "breakpoints.hpp"
+
+#include <memory>
+
+
+namespace genesis::memory
+{
+
+// Checks every access to the wrapped device against watchpoints.
+// CPUs put it in front of their memory only while watchpoints are set.
+template <class Breakpoints>
+class watching_memory : public memory::addressable
+{
+public:
+	watching_memory(std::shared_ptr<addressable> unit, Breakpoints& bps) : m_unit(std::move(unit)), m_bps(bps)
+	{
+	}
+
+	const std::shared_ptr<addressable>& unit() const
+	{
+		return m_unit;
+	}
+
+	std::uint32_t max_address() const override
+	{
+		return m_unit->max_address();
+	}
+
+	bool is_idle() const override
+	{
+		return m_unit->is_idle();
+	}
+
+	void init_write(std::uint32_t address, std::uint8_t data) override
+	{
+		m_unit->init_write(address, data);
+		m_bps.check_access(break_type::write, address, sizeof(data));
+	}
+
+	void init_write(std::uint32_t address, std::uint16_t data) override
+	{
+		m_unit->init_write(address, data);
+		m_bps.check_access(break_type::write, address, sizeof(data));
+	}
+
+	void init_read_byte(std::uint32_t address) override
+	{
+		m_unit->init_read_byte(address);
+		m_bps.check_access(break_type::read, address, sizeof(std::uint8_t));
+	}
+
+	void init_read_word(std::uint32_t address) override
+	{
+		m_unit->init_read_word(address);
+		m_bps.check_access(break_type::read, address, sizeof(std::uint16_t));
+	}
+
+	std::uint8_t latched_byte() const override
+	{
+		return m_unit->latched_byte();
+	}
+
+	std::uint16_t latched_word() const override
+	{
+		return m_unit->latched_word();
+	}
+
+	bool is_synchronous(std::uint32_t address) const override
+	{
+		return m_unit->is_synchronous(address);
+	}
+
+	std::uint8_t read_byte_now(std::uint32_t address) override
+	{
+		auto data = m_unit->read_byte_now(address);
+		m_bps.check_access(break_type::read, address, sizeof(data));
+		return data;
+	}
+
+	std::uint16_t read_word_now(std::uint32_t address) override
+	{
+		auto data = m_unit->read_word_now(address);
+		m_bps.check_access(break_type::read, address, sizeof(data));
+		return data;
+	}
+
+	// block transfers use the default byte by byte implementation, so every byte is checked
+
+private:
+	std::shared_ptr<addressable> m_unit;
+	Breakpoints& m_bps;
+};
+
+} // namespace genesis::memory
+
+#endif // __MEMORY_WATCHING_MEMORY_H__
@@ -0,0 +1,182 @@
+#ifndef __GENESIS_PERF_COUNTERS_H__
+#define __GENESIS_PERF_COUNTERS_H__
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+
+/*
+ * Low-overhead performance counters.
+ *
+ * The registry itself is always available, but the GENESIS_PERF_* macros used by the emulation core
+ * expand to nothing unless the project is configured with ENABLE_PERF_COUNTERS=ON.
+ *
+ * Every call site caches a reference to its counter in a function-local static,
+ * so after the first hit a counter update is a single add.
+ */
+
+namespace genesis::perf
+{
+
+#ifdef GENESIS_PERF_COUNTERS
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+class counter
+{
+public:
+	explicit counter(std::string name) : m_name(std::move(name))
+	{
+	}
+
+	const std::string& name() const
+	{
+		return m_name;
+	}
+
+	std::uint64_t value() const
+	{
+		return m_value;
+	}
+
+	void add(std::uint64_t value)
+	{
+		m_value += value;
+	}
+
+	void reset()
+	{
+		m_value = 0;
+	}
+
+private:
+	std::string m_name;
+	std::uint64_t m_value = 0;
+};
+
+class registry
+{
+public:
+	static registry& instance()
+	{
+		static registry reg;
+		return reg;
+	}
+
+	// Returns counter with specified name, creates a new one if it does not exist yet.
+	// Returned reference stays valid for the lifetime of the program.
+	counter& get(std::string_view name)
+	{
+		for(auto& c : m_counters)
+		{
+			if(c.name() == name)
+				return c;
+		}
+
+		return m_counters.emplace_back(std::string{name});
+	}
+
+	// Returns 0 if counter does not exist
+	std::uint64_t value(std::string_view name) const
+	{
+		for(const auto& c : m_counters)
+		{
+			if(c.name() == name)
+				return c.value();
+		}
+
+		return 0;
+	}
+
+	const std::deque<counter>& counters() const
+	{
+		return m_counters;
+	}
+
+	void reset()
+	{
+		for(auto& c : m_counters)
+			c.reset();
+	}
+
+	void dump(std::ostream& os) const
+	{
+		std::size_t width = 0;
+		for(const auto& c : m_counters)
+			width = std::max(width, c.name().size());
+
+		os << "==== Performance counters ====\n";
+		for(const auto& c : m_counters)
+			os << std::left << std::setw(width) << c.name() << " : " << std::right << c.value() << '\n';
+		os << "==============================\n";
+	}
+
+private:
+	registry() = default;
+
+private:
+	// use deque so references returned by get() are not invalidated
+	std::deque<counter> m_counters;
+};
+
+// Adds elapsed time (in ns) to the counter on scope exit
+class scoped_timer
+{
+public:
+	explicit scoped_timer(counter& c) : m_counter(c), m_start(std::chrono::high_resolution_clock::now())
+	{
+	}
+
+	~scoped_timer()
+	{
+		auto stop = std::chrono::high_resolution_clock::now();
+		auto dur = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - m_start);
+		m_counter.add(dur.count());
+	}
+
+private:
+	counter& m_counter;
+	std::chrono::high_resolution_clock::time_point m_start;
+};
+
+}; // namespace genesis::perf
+
+#ifdef GENESIS_PERF_COUNTERS
+
+#define GENESIS_PERF_ADD(name, value)                                                                                  \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		static ::genesis::perf::counter& perf_counter_ = ::genesis::perf::registry::instance().get(name);              \
+		perf_counter_.add(value);                                                                                      \
+	} while(false)
+
+// Measures time till the end of the current scope, only one timer per scope is allowed
+#define GENESIS_PERF_SCOPE(name)                                                                                       \
+	static ::genesis::perf::counter& perf_scope_counter_ = ::genesis::perf::registry::instance().get(name);            \
+	::genesis::perf::scoped_timer perf_scope_timer_(perf_scope_counter_)
+
+#else
+
+#define GENESIS_PERF_ADD(name, value)                                                                                  \
+	do                                                                                                                 \
+	{                                                                                                                  \
+	} while(false)
+
+#define GENESIS_PERF_SCOPE(name)                                                                                       \
+	do                                                                                                                 \
+	{                                                                                                                  \
+	} while(false)
+
+#endif
+
+#define GENESIS_PERF_INC(name) GENESIS_PERF_ADD(name, 1)
+
+#endif // __GENESIS_PERF_COUNTERS_H__
@@ -156,6 +156,20 @@ void rom::setup_header()
 	m_header.rom_end_addr = read_builtin_type<std::uint32_t>(m_rom_data, 0x1A4);
 	m_header.ram_start_addr = read_builtin_type<std::uint32_t>(m_rom_data, 0x1A8);
 	m_header.ram_end_addr = read_builtin_type<std::uint32_t>(m_rom_data, 0x1AC);
+
+	// "RA", type byte with battery backup bit, 0x20 (0x40 is used by EEPROM)
+	std::string_view extra_memory = read_string_view(m_rom_data, 0x1B0, 2);
+	std::uint8_t type = read_builtin_type<std::uint8_t>(m_rom_data, 0x1B2);
+	std::uint8_t kind = read_builtin_type<std::uint8_t>(m_rom_data, 0x1B3);
+	if(extra_memory == "RA" && (type & 0x40) != 0 && kind == 0x20)
+	{
+		sram_data sram;
+		sram.start_addr = read_builtin_type<std::uint32_t>(m_rom_data, 0x1B4);
+		sram.end_addr = read_builtin_type<std::uint32_t>(m_rom_data, 0x1B8);
+
+		if(sram.start_addr <= sram.end_addr)
+			m_header.sram = sram;
+	}
 }
 
 void rom::setup_vectors()
@@ -18,6 +18,15 @@ public:
 	static const constexpr std::size_t MAX_SIZE = 0x400000;
 	static const constexpr std::size_t MIN_SIZE = 0x201; // header + vector + 1 body byte
 
+	// battery backed RAM declared in the extra memory field of the header
+	struct sram_data
+	{
+		bool operator==(const sram_data&) const = default;
+
+		std::uint32_t start_addr;
+		std::uint32_t end_addr;
+	};
+
 	struct header_data
 	{
 		bool operator==(const header_data&) const = default;
@@ -35,6 +44,8 @@ public:
 
 		std::uint32_t ram_start_addr;
 		std::uint32_t ram_end_addr;
+
+		std::optional<sram_data> sram = std::nullopt;
 	};
 
 	using vector_array = std::array<std::uint32_t, 64>;
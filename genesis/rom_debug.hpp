@@ -22,6 +22,11 @@ namespace genesis::debug
 	os << "ROM checksum: " << hex_str(header.rom_checksum) << std::endl;
 	os << "ROM address range: " << hex_str(header.rom_start_addr) << " - " << hex_str(header.rom_end_addr) << std::endl;
 	os << "RAM address range: " << hex_str(header.ram_start_addr) << " - " << hex_str(header.ram_end_addr) << std::endl;
+	if(header.sram.has_value())
+	{
+		os << "SRAM address range: " << hex_str(header.sram->start_addr) << " - " << hex_str(header.sram->end_addr)
+		   << std::endl;
+	}
 }
 
 template <class array, class format_func>
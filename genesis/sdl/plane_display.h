@@ -2,7 +2,7 @@
 #define __GENESIS_SDL_PLANE_DISPLAY_H__
 
 #include "base_display.h"
-#include "time_utils.h"
+#include "perf_counters.h"
 #include "vdp/output_color.h"
 
 #include <array>
@@ -96,25 +96,34 @@ public:
 			m_texture = create_texture(m_width, m_height);
 		}
 
-		/* auto ns =  */ time::measure_in_ns([&]() {
-			int pixel_pos = 0;
-			for(int row_number = 0; row_number < m_height; ++row_number)
+		render();
+		present();
+	}
+
+private:
+	void render()
+	{
+		GENESIS_PERF_SCOPE("sdl.render_ns");
+
+		int pixel_pos = 0;
+		for(int row_number = 0; row_number < m_height; ++row_number)
+		{
+			auto row = m_get_row(row_number, buffer);
+			for(auto color : row)
 			{
-				auto row = m_get_row(row_number, buffer);
-				for(auto color : row)
-				{
-					// TODO: use alpha
-					std::uint32_t pix = 0x0;
-					pix |= color.red << 21;
-					pix |= color.green << 13;
-					pix |= color.blue << 5;
-					pixels.at(pixel_pos++) = pix;
-				}
+				// TODO: use alpha
+				std::uint32_t pix = 0x0;
+				pix |= color.red << 21;
+				pix |= color.green << 13;
+				pix |= color.blue << 5;
+				pixels.at(pixel_pos++) = pix;
 			}
-		});
+		}
+	}
 
-		// double ms = (double)ns / 1'000'000;
-		// std::cout << "Forming " << m_title << " frame took " << std::setprecision(3) << ms << " ms\n";
+	void present()
+	{
+		GENESIS_PERF_SCOPE("sdl.present_ns");
 
 		SDL_SetWindowSize(m_window, m_width, m_height);
 		SDL_UpdateTexture(m_texture, nullptr, pixels.data(), 4 * m_width);
@@ -123,7 +132,6 @@ public:
 		SDL_RenderPresent(m_renderer);
 	}
 
-private:
 	SDL_Texture* create_texture(int width, int height)
 	{
 		return SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, width, height);
@@ -0,0 +1,216 @@
+#ifndef __SMD_IMPL_CARTRIDGE_SRAM_H__
+#define __SMD_IMPL_CARTRIDGE_SRAM_H__
+
+#include "exception.hpp"
+#include "memory/addressable.h"
+#include "memory/base_unit.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace genesis::impl
+{
+
+// $A130F1, bit 0 maps SRAM instead of ROM, bit 1 protects SRAM from writes
+class sram_control_register : public memory::addressable
+{
+public:
+	sram_control_register(bool sram_enabled) : m_value(sram_enabled ? 0b01 : 0b00)
+	{
+	}
+
+	/* addressable interface */
+	std::uint32_t max_address() const override
+	{
+		return 0x1;
+	}
+
+	bool is_idle() const override
+	{
+		return true;
+	}
+
+	void init_write(std::uint32_t address, std::uint8_t data) override
+	{
+		// only odd byte is connected
+		if(address == 0x1)
+			m_value = data & 0b11;
+	}
+
+	void init_write(std::uint32_t /* address */, std::uint16_t data) override
+	{
+		m_value = data & 0b11;
+	}
+
+	// register is write only
+	void init_read_byte(std::uint32_t /* address */) override
+	{
+	}
+
+	void init_read_word(std::uint32_t /* address */) override
+	{
+	}
+
+	std::uint8_t latched_byte() const override
+	{
+		return 0x0;
+	}
+
+	std::uint16_t latched_word() const override
+	{
+		return 0x0;
+	}
+
+	bool sram_enabled() const
+	{
+		return (m_value & 0b01) != 0;
+	}
+
+	bool write_protected() const
+	{
+		return (m_value & 0b10) != 0;
+	}
+
+private:
+	std::uint8_t m_value;
+};
+
+/* Serves upper half of the cartridge address space ($200000-$3FFFFF).
+ * SRAM replaces ROM in this area while it is enabled by sram_control_register.
+ * Only ROM of a cartridge with SRAM goes through this indirection, other accesses are mapped directly.
+ */
+class cartridge_sram_area : public memory::addressable
+{
+public:
+	static constexpr std::uint32_t area_start = 0x200000;
+	static constexpr std::uint32_t area_end = 0x3FFFFF;
+
+public:
+	// rom - the whole ROM, sram_start - SRAM address relative to the area_start
+	cartridge_sram_area(std::shared_ptr<memory::addressable> rom, std::span<std::uint8_t> sram,
+						std::uint32_t sram_start, std::shared_ptr<sram_control_register> control)
+		: m_rom(std::move(rom)), m_sram(sram), m_sram_start(sram_start), m_control(std::move(control))
+	{
+		if(sram_start + sram.size() - 1 > area_end - area_start)
+			throw internal_error("SRAM does not fit into the cartridge area");
+	}
+
+	std::uint32_t max_address() const override
+	{
+		return area_end - area_start;
+	}
+
+	bool is_idle() const override
+	{
+		return true;
+	}
+
+	void init_write(std::uint32_t address, std::uint8_t data) override
+	{
+		write(address, data);
+	}
+
+	void init_write(std::uint32_t address, std::uint16_t data) override
+	{
+		write(address, data);
+	}
+
+	void init_read_byte(std::uint32_t address) override
+	{
+		m_last_device = &route(address);
+		m_last_device->init_read_byte(address);
+	}
+
+	void init_read_word(std::uint32_t address) override
+	{
+		m_last_device = &route(address);
+		m_last_device->init_read_word(address);
+	}
+
+	std::uint8_t latched_byte() const override
+	{
+		if(m_last_device == nullptr)
+			throw internal_error();
+		return m_last_device->latched_byte();
+	}
+
+	std::uint16_t latched_word() const override
+	{
+		if(m_last_device == nullptr)
+			throw internal_error();
+		return m_last_device->latched_word();
+	}
+
+	bool is_synchronous(std::uint32_t address) const override
+	{
+		// SRAM is a buffer, ROM is provided by the caller
+		return is_sram(address) || m_rom->is_synchronous(address + area_start);
+	}
+
+	std::uint8_t read_byte_now(std::uint32_t address) override
+	{
+		auto& dev = route(address);
+		return dev.read_byte_now(address);
+	}
+
+	std::uint16_t read_word_now(std::uint32_t address) override
+	{
+		auto& dev = route(address);
+		return dev.read_word_now(address);
+	}
+
+private:
+	// SRAM buffer is provided by the caller, so it can be backed by a file
+	class sram_unit : public memory::base_unit<std::endian::big>
+	{
+	public:
+		sram_unit(std::span<std::uint8_t> buffer) : base_unit(buffer)
+		{
+		}
+	};
+
+	template <class T>
+	void write(std::uint32_t address, T data)
+	{
+		auto& dev = route(address);
+		if(&dev == &m_sram && m_control->write_protected())
+		{
+			m_last_device = nullptr;
+			return;
+		}
+
+		m_last_device = &dev;
+		dev.init_write(address, data);
+	}
+
+	bool is_sram(std::uint32_t address) const
+	{
+		return m_control->sram_enabled() && address >= m_sram_start && address - m_sram_start <= m_sram.max_address();
+	}
+
+	// converts address to the device address
+	addressable& route(std::uint32_t& address)
+	{
+		if(is_sram(address))
+		{
+			address -= m_sram_start;
+			return m_sram;
+		}
+
+		address += area_start;
+		return *m_rom;
+	}
+
+private:
+	std::shared_ptr<memory::addressable> m_rom;
+	sram_unit m_sram;
+	std::uint32_t m_sram_start;
+	std::shared_ptr<sram_control_register> m_control;
+
+	addressable* m_last_device = nullptr;
+};
+
+} // namespace genesis::impl
+
+#endif // __SMD_IMPL_CARTRIDGE_SRAM_H__
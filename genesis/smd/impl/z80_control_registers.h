@@ -25,8 +25,8 @@ private:
 public:
 	z80_control_registers()
 	{
-		m_z80_request = std::make_shared<memory::memory_unit>(0x1, std::endian::big);
-		m_z80_reset = std::make_shared<memory::memory_unit>(0x1, std::endian::big);
+		m_z80_request = std::make_shared<memory::memory_unit<std::endian::big>>(0x1);
+		m_z80_reset = std::make_shared<memory::memory_unit<std::endian::big>>(0x1);
 
 		reset();
 	}
@@ -114,8 +114,8 @@ public:
 private:
 	bool m_z80_bus_granted;
 	bool m_z80_reset_requested;
-	std::shared_ptr<memory::memory_unit> m_z80_request;
-	std::shared_ptr<memory::memory_unit> m_z80_reset;
+	std::shared_ptr<memory::memory_unit<std::endian::big>> m_z80_request;
+	std::shared_ptr<memory::memory_unit<std::endian::big>> m_z80_reset;
 };
 
 } // namespace genesis::impl
@@ -1,5 +1,6 @@
 #include "smd.h"
 
+#include "impl/cartridge_sram.h"
 #include "impl/m68k_bus_access.h"
 #include "impl/m68k_interrupt_access.h"
 #include "impl/z80_68bank.h"
@@ -7,24 +8,42 @@
 #include "io_ports/controller.h"
 #include "io_ports/disabled_port.h"
 #include "memory/dummy_memory.h"
-#include "memory/logging_memory.h"
 #include "memory/memory_builder.h"
 #include "memory/memory_unit.h"
 #include "memory/read_only_memory_unit.h"
+#include "memory/tracing_memory.h"
 
 
 namespace genesis
 {
 
-smd::smd(const genesis::rom& rom, std::shared_ptr<io_ports::input_device> input_dev1) : m_input_dev1(input_dev1)
+smd::smd(const genesis::rom& rom, std::shared_ptr<io_ports::input_device> input_dev1,
+		 std::optional<memory::bus_trace_settings> bus_trace, const cheat_list& cheats,
+		 const std::filesystem::path& sram_file)
+	: m_input_dev1(input_dev1), m_ram_freezes(cheats.ram_freezes())
 {
 	m_vdp = std::make_unique<vdp::vdp>();
+	m_vdp->on_frame_end([this]() { frame_end(); });
 
-	build_cpu_memory_map(rom);
+	setup_sram(rom, sram_file);
+	build_cpu_memory_map(rom, cheats);
+
+	auto z80_mem_map = m_z80_mem_map;
+	if(bus_trace.has_value())
+	{
+		m_bus_trace = std::make_unique<memory::bus_trace_recorder>(*bus_trace, cycles);
+		m_m68k_mem_map = std::make_shared<memory::tracing_memory>(m_m68k_mem_map, *m_bus_trace, m68k_bus_trace_id);
+		z80_mem_map = std::make_shared<memory::tracing_memory>(z80_mem_map, *m_bus_trace, z80_bus_trace_id);
+	}
+
+	auto z80_mem = std::make_shared<z80::memory>(z80_mem_map);
+
+	// direct access would bypass the tracer
+	if(!m_bus_trace)
+		z80_mem->set_direct_ram(*m_z80_ram, 0x4000); // main RAM + mirror
 
-	// z80::memory z80_mem(m_z80_mem_map);
 	auto z80_ports = std::make_shared<impl::z80_io_ports>();
-	m_z80_cpu = std::make_unique<z80::cpu>(std::make_shared<z80::memory>(m_z80_mem_map), z80_ports);
+	m_z80_cpu = std::make_unique<z80::cpu>(z80_mem, z80_ports);
 
 	auto m68k_int_access = std::make_shared<impl::m68k_interrupt_access_impl>();
 	m_m68k_cpu = std::make_unique<m68k::cpu>(m_m68k_mem_map, m68k_int_access);
@@ -52,6 +71,25 @@ void smd::cycle()
 	m_vdp->cycle();
 }
 
+void smd::frame_end()
+{
+	// RAM is written directly, so freezes do not add cost to bus accesses
+	if(!m_ram_freezes.empty())
+		apply_patches(m_ram_freezes, *m_m68k_ram, 0xFFFF);
+
+	if(m_frame_end_callback)
+		m_frame_end_callback();
+}
+
+void smd::enable_idle_loop_skipping()
+{
+	m_m68k_cpu->enable_idle_loop_skipping([](std::uint32_t address) {
+		const bool ram = address >= 0xE00000;
+		const bool vdp_status = address >= 0xC00004 && address <= 0xC00007;
+		return ram || vdp_status;
+	});
+}
+
 void smd::z80_cycle()
 {
 	m_z80_ctrl_registers.cycle();
@@ -70,15 +108,16 @@ void smd::z80_cycle()
 	m_z80_cpu->execute_one();
 }
 
-void smd::build_cpu_memory_map(const genesis::rom& rom)
+void smd::build_cpu_memory_map(const genesis::rom& rom, const cheat_list& cheats)
 {
-	auto rom_data = load_rom(rom);
+	auto rom_data = load_rom(rom, cheats.rom_patches());
 
 	/* Build z80 memory map */
 	memory::memory_builder z80_builder;
 
-	z80_builder.add_unique(memory::make_memory_unit(0x1FFF, std::endian::little), 0x0, 0x1FFF); // main RAM
-	z80_builder.mirror(0x0, 0x1FFF, 0x2000, 0x3FFF);											// main RAM mirrored
+	// main RAM, mirrored every $1FFF
+	m_z80_ram = std::make_shared<std::vector<std::uint8_t>>(0x2000);
+	z80_builder.add_unique(std::make_unique<memory::memory_unit<std::endian::little>>(m_z80_ram), 0x0, 0x3FFF, 0x1FFF);
 
 	z80_builder.add_unique(std::make_unique<memory::dummy_memory>(0x0, std::endian::little), 0x4000, 0x4000);
 	z80_builder.add_unique(std::make_unique<memory::zero_memory_unit>(0x0, std::endian::little), 0x4001, 0x4001);
@@ -90,18 +129,18 @@ void smd::build_cpu_memory_map(const genesis::rom& rom)
 	// auto ym2612 = std::make_shared<memory::dummy_memory>(0x3, std::endian::little);
 	// z80_builder.add(ym2612, 0x4000, 0x4003); // YM2612
 
-	// z80_builder.add(std::make_shared<memory::memory_unit>(0x1FFB, std::endian::little), 0x4004, 0x5FFF); // TMP
+	// z80_builder.add(std::make_shared<memory::memory_unit<std::endian::little>>(0x1FFB), 0x4004, 0x5FFF); // TMP
 	z80_builder.add_unique(std::make_unique<memory::dummy_memory>(0x0, std::endian::little), 0x7F11, 0x7F11); // PSG
 
 
 	// TODO: only rom is accessible for now
-	impl::z80_68bank z80_bank(std::make_shared<memory::memory_unit>(rom_data, std::endian::big));
+	impl::z80_68bank z80_bank(std::make_shared<memory::memory_unit<std::endian::big>>(rom_data));
 	z80_builder.add(z80_bank.bank_register(), 0x6000, 0x6000);
 	z80_builder.add(z80_bank.bank_area(), 0x8000, 0xFFFF);
 
-	// z80_builder.add(std::make_shared<memory::memory_unit>(0x1FFF, std::endian::little), 0x2000, 0x3FFF); // reserved
-	// z80_builder.add(std::make_shared<memory::memory_unit>(0x1F0F, std::endian::little), 0x6001, 0x7F10); // reserved
-	// z80_builder.add(std::make_shared<memory::memory_unit>(0xED, std::endian::little), 0x7F12, 0x7FFF); // reserved
+	// z80_builder.add(std::make_shared<memory::memory_unit<std::endian::little>>(0x1FFF), 0x2000, 0x3FFF); // reserved
+	// z80_builder.add(std::make_shared<memory::memory_unit<std::endian::little>>(0x1F0F), 0x6001, 0x7F10); // reserved
+	// z80_builder.add(std::make_shared<memory::memory_unit<std::endian::little>>(0xED), 0x7F12, 0x7FFF); // reserved
 
 	m_z80_mem_map = z80_builder.build();
 
@@ -110,34 +149,48 @@ void smd::build_cpu_memory_map(const genesis::rom& rom)
 	// Setup version register based on the loaded rom
 	m68k_builder.add_unique(build_version_register(rom), 0xA10000, 0xA10001);
 
-	m68k_builder.add_unique(std::make_unique<memory::memory_unit>(rom_data, std::endian::big), 0x0, 0x3FFFFF);
+	auto rom_unit = std::make_shared<memory::memory_unit<std::endian::big>>(rom_data);
+
+	// SRAM can be mapped over ROM, ROM is accessed directly if there is no SRAM
+	auto sram_control = std::make_shared<impl::sram_control_register>(rom.data().size() <= m_sram_start);
+	if(!m_sram.empty())
+	{
+		using area = impl::cartridge_sram_area;
+		auto sram_area = std::make_shared<area>(rom_unit, m_sram, m_sram_start - area::area_start, sram_control);
+
+		m68k_builder.add(rom_unit, 0x0, area::area_start - 1);
+		m68k_builder.add(sram_area, area::area_start, area::area_end);
+	}
+	else
+	{
+		m68k_builder.add(rom_unit, 0x0, 0x3FFFFF);
+	}
+
+	m68k_builder.add(sram_control, 0xA130F0, 0xA130F1);
 	m68k_builder.add(m_z80_mem_map, 0xA00000, 0xA0FFFF);
 
-	// M68K RAM, mirrored every $FFFF
+	// M68K RAM, mirrored every $FFFF up to the end of address space
 	const std::uint32_t M68K_RAM_START = 0xE00000;
-	const std::uint32_t M68K_RAM_END = 0xE0FFFF;
+	const std::uint32_t M68K_RAM_END = 0xFFFFFF;
 	const std::uint32_t M68K_RAM_HA = 0xFFFF;
 
-	m68k_builder.add_unique(memory::make_memory_unit(M68K_RAM_HA, std::endian::big), M68K_RAM_START, M68K_RAM_END);
-	for(int i = 1; i <= 32; ++i)
-	{
-		std::uint32_t mirror_start = M68K_RAM_START + ((M68K_RAM_HA + 1) * i);
-		std::uint32_t mirror_end = mirror_start + M68K_RAM_HA;
-		m68k_builder.mirror(M68K_RAM_START, M68K_RAM_END, mirror_start, mirror_end);
-	}
+	m_m68k_ram = std::make_shared<std::vector<std::uint8_t>>(M68K_RAM_HA + 1);
+	auto m68k_ram = std::make_unique<memory::memory_unit<std::endian::big, memory::debug_checked_bounds>>(m_m68k_ram);
+	m68k_builder.add_unique(std::move(m68k_ram), M68K_RAM_START, M68K_RAM_END, M68K_RAM_HA);
 
 	// TMSS register
-	m68k_builder.add_unique(memory::make_memory_unit(0x3, std::endian::big), 0xA14000, 0xA14003);
+	m68k_builder.add_unique(memory::make_memory_unit<std::endian::big>(0x3), 0xA14000, 0xA14003);
 
 	// TMSS/cartridge register
-	m68k_builder.add_unique(memory::make_memory_unit(0x1, std::endian::big), 0xA14101, 0xA14102);
+	m68k_builder.add_unique(memory::make_memory_unit<std::endian::big>(0x1), 0xA14101, 0xA14102);
 
 	// Reserved
-	// m68k_builder.add(std::make_shared<memory::memory_unit>(0x2DFD, std::endian::big), 0xA11202, 0xA13FFF);
-	m68k_builder.add_unique(memory::make_memory_unit(0x1EEDFD, std::endian::big), 0xA11202, 0xBFFFFF);
-	// m68k_builder.add(std::make_shared<memory::memory_unit>(0xFFFF, std::endian::big), 0xBF0000, 0xBFFFFF);
-	// m68k_builder.add(std::make_shared<memory::memory_unit>(0x3EFFDF, std::endian::big), 0xC00020, 0xFEFFFF);
-	// m68k_builder.add(std::make_shared<memory::memory_unit>(0x0, std::endian::big), 0x009FFFFF, 0x009FFFFF);
+	// m68k_builder.add(std::make_shared<memory::memory_unit<std::endian::big>>(0x2DFD), 0xA11202, 0xA13FFF);
+	m68k_builder.add_unique(memory::make_memory_unit<std::endian::big>(0x1EED), 0xA11202, 0xA130EF);
+	m68k_builder.add_unique(memory::make_memory_unit<std::endian::big>(0x1ECF0D), 0xA130F2, 0xBFFFFF);
+	// m68k_builder.add(std::make_shared<memory::memory_unit<std::endian::big>>(0xFFFF), 0xBF0000, 0xBFFFFF);
+	// m68k_builder.add(std::make_shared<memory::memory_unit<std::endian::big>>(0x3EFFDF), 0xC00020, 0xFEFFFF);
+	// m68k_builder.add(std::make_shared<memory::memory_unit<std::endian::big>>(0x0), 0x009FFFFF, 0x009FFFFF);
 
 	// VDP Ports
 	m68k_builder.add(m_vdp->io_ports(), 0xC00000, 0xC00007);
@@ -168,6 +221,32 @@ void smd::build_cpu_memory_map(const genesis::rom& rom)
 	m_m68k_mem_map = m68k_builder.build();
 }
 
+void smd::setup_sram(const genesis::rom& rom, const std::filesystem::path& sram_file)
+{
+	const auto& sram = rom.header().sram;
+
+	// only SRAM in the upper half of the cartridge area is supported
+	using area = impl::cartridge_sram_area;
+	if(!sram.has_value() || sram->start_addr < area::area_start || sram->end_addr > area::area_end)
+		return;
+
+	// keep both bytes of a word even if SRAM is connected only to odd or even addresses
+	m_sram_start = sram->start_addr & ~1u;
+	const std::size_t sram_size = (sram->end_addr | 1u) - m_sram_start + 1;
+
+	if(sram_file.empty())
+	{
+		m_sram_buffer.resize(sram_size, 0xFF);
+		m_sram = m_sram_buffer;
+	}
+	else
+	{
+		// the OS writes SRAM back to the file, so writes are not flushed explicitly
+		m_sram_file = std::make_unique<memory::mapped_file>(sram_file, sram_size);
+		m_sram = m_sram_file->data();
+	}
+}
+
 std::unique_ptr<memory::addressable> smd::build_version_register(const genesis::rom& rom)
 {
 	auto supports = [&rom](char region_type) { return rom.header().region_support.contains(region_type); };
@@ -189,12 +268,13 @@ std::unique_ptr<memory::addressable> smd::build_version_register(const genesis::
 
 	reg_value |= 0b0001; // Version number
 
-	auto version_register = std::make_unique<memory::read_only_memory_unit>(0x1, std::endian::big);
+	auto version_register = std::make_unique<memory::read_only_memory_unit<std::endian::big>>(0x1);
 	version_register->write<std::uint16_t>(0, reg_value);
 	return version_register;
 }
 
-std::shared_ptr<std::vector<std::uint8_t>> smd::load_rom(const genesis::rom& rom)
+std::shared_ptr<std::vector<std::uint8_t>> smd::load_rom(const genesis::rom& rom,
+														 std::span<const cheat_patch> patches)
 {
 	const std::uint32_t ROM_SIZE = 0x400000;
 
@@ -211,6 +291,9 @@ std::shared_ptr<std::vector<std::uint8_t>> smd::load_rom(const genesis::rom& rom
 	for(std::size_t i = rom_data->size(); i < ROM_SIZE; ++i)
 		rom_data->push_back(0);
 
+	// patch ROM before it is mapped, so patched ROM is accessed as usual
+	apply_patches(patches, *rom_data, 0xFFFFFF);
+
 	return rom_data;
 }
 
@@ -1,15 +1,21 @@
 #ifndef __SMD_H__
 #define __SMD_H__
 
+#include "cheats.h"
 #include "impl/z80_control_registers.h"
 #include "io_ports/input_device.h"
 #include "m68k/cpu.h"
 #include "memory/addressable.h"
+#include "memory/bus_trace.h"
+#include "memory/mapped_file.h"
 #include "rom.h"
 #include "vdp/vdp.h"
 #include "z80/cpu.h"
 
+#include <filesystem>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string_view>
 
 namespace genesis
@@ -19,24 +25,66 @@ namespace genesis
 class smd
 {
 public:
-	smd(const genesis::rom& rom, std::shared_ptr<io_ports::input_device> input_dev1);
+	// device ids of bus trace records
+	static constexpr std::uint8_t m68k_bus_trace_id = 0;
+	static constexpr std::uint8_t z80_bus_trace_id = 1;
+
+public:
+	// bus_trace enables recording of all m68k and z80 bus accesses
+	// cheats patch ROM once at construction and freeze RAM at the end of every frame
+	// sram_file keeps cartridge SRAM between sessions, SRAM is not saved if path is empty
+	smd(const genesis::rom& rom, std::shared_ptr<io_ports::input_device> input_dev1,
+		std::optional<memory::bus_trace_settings> bus_trace = std::nullopt, const cheat_list& cheats = {},
+		const std::filesystem::path& sram_file = {});
 
 	void cycle();
 
+	// called after RAM freezes are applied
+	void on_frame_end(std::function<void()> callback)
+	{
+		m_frame_end_callback = std::move(callback);
+	}
+
+	// m68k skips loops which poll only RAM or VDP status register, see m68k::cpu::enable_idle_loop_skipping
+	void enable_idle_loop_skipping();
+
 	vdp::vdp& vdp()
 	{
 		return *m_vdp;
 	}
 
+	m68k::cpu& m68k_cpu()
+	{
+		return *m_m68k_cpu;
+	}
+
+	// m68k memory map as seen by the CPU
+	memory::addressable& m68k_memory()
+	{
+		return *m_m68k_mem_map;
+	}
+
 private:
-	void build_cpu_memory_map(const genesis::rom& rom);
+	void build_cpu_memory_map(const genesis::rom& rom, const cheat_list& cheats);
+	void setup_sram(const genesis::rom& rom, const std::filesystem::path& sram_file);
+	void frame_end();
 
 	static std::unique_ptr<memory::addressable> build_version_register(const genesis::rom& rom);
-	static std::shared_ptr<std::vector<std::uint8_t>> load_rom(const genesis::rom& rom);
+	static std::shared_ptr<std::vector<std::uint8_t>> load_rom(const genesis::rom& rom,
+															   std::span<const cheat_patch> patches);
 
 private:
+	// must outlive the memory map
+	std::unique_ptr<memory::mapped_file> m_sram_file;
+	std::vector<std::uint8_t> m_sram_buffer;
+	std::span<std::uint8_t> m_sram;
+	std::uint32_t m_sram_start = 0;
+
 	std::shared_ptr<memory::addressable> m_m68k_mem_map;
 	std::shared_ptr<memory::addressable> m_z80_mem_map;
+	std::shared_ptr<std::vector<std::uint8_t>> m_z80_ram;
+	std::shared_ptr<std::vector<std::uint8_t>> m_m68k_ram;
+	std::unique_ptr<memory::bus_trace_recorder> m_bus_trace;
 
 	// tmp
 	void z80_cycle();
@@ -47,10 +95,13 @@ protected:
 	std::unique_ptr<z80::cpu> m_z80_cpu;
 	std::unique_ptr<vdp::vdp> m_vdp;
 
-	unsigned cycles = 0;
+	std::uint64_t cycles = 0;
 
 private:
 	std::shared_ptr<io_ports::input_device> m_input_dev1;
+
+	std::vector<cheat_patch> m_ram_freezes;
+	std::function<void()> m_frame_end_callback;
 };
 
 } // namespace genesis
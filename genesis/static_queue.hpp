@@ -1,76 +1,102 @@
-#ifndef __M68K_STATIC_QUEUE_HPP__
-#define __M68K_STATIC_QUEUE_HPP__
-
-#include <cstddef>
-#include <vector>
-#include <iostream>
-
-namespace genesis
-{
-
-template<class T>
-class static_queue
-{
-public:
-	using value_type = T;
-public:
-	static_queue(std::size_t size = 100)
-	{
-		// std::cout << "Allocating about " << sizeof(value_type) * size << " bytes for buffer" << std::endl;
-		// buffer.reserve(size);
-		// buffer.resize(size);
-	}
-
-	std::size_t capacity() const
-	{
-		// return buffer.capacity();
-		return 100;
-	}
-
-	bool empty() const
-	{
-		return free_slot == first_slot;
-	}
-
-	void reset()
-	{
-		free_slot = first_slot = 0;
-	}
-
-	void push(const T& val)
-	{
-		buffer[free_slot] = val;
-		free_slot = (free_slot + 1) % capacity();
-	}
-
-	void push(T&& val)
-	{
-		buffer[free_slot] = std::move(val);
-		free_slot = (free_slot + 1) % capacity();
-	}
-
-	value_type& front()
-	{
-		return buffer[first_slot];
-	}
-
-	value_type& front() const
-	{
-		return buffer[first_slot];
-	}
-
-	void pop()
-	{
-		first_slot = (first_slot + 1) % capacity();
-	}
-
-private:
-	// std::vector<value_type> buffer;
-	value_type buffer[100];
-	std::size_t free_slot = 0;
-	std::size_t first_slot = 0;
-};
-
-};
-
-#endif // __M68K_STATIC_QUEUE_HPP__
+#ifndef __STATIC_QUEUE_HPP__
+#define __STATIC_QUEUE_HPP__
+
+#include "exception.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+namespace genesis
+{
+
+// Fixed-capacity FIFO queue, stores elements inline and never allocates
+// Capacity must be a power of 2
+template <class T, std::size_t Capacity>
+class static_queue
+{
+	static_assert(std::has_single_bit(Capacity), "capacity must be a power of 2");
+
+public:
+	using value_type = T;
+
+public:
+	static constexpr std::size_t capacity()
+	{
+		return Capacity;
+	}
+
+	std::size_t size() const
+	{
+		return free_slot - first_slot;
+	}
+
+	bool empty() const
+	{
+		return free_slot == first_slot;
+	}
+
+	bool full() const
+	{
+		return size() == capacity();
+	}
+
+	void clear()
+	{
+		free_slot = first_slot = 0;
+	}
+
+	void push(const T& val)
+	{
+		next_free_slot() = val;
+	}
+
+	void push(T&& val)
+	{
+		next_free_slot() = std::move(val);
+	}
+
+	template <class... Args>
+	void emplace(Args&&... args)
+	{
+		next_free_slot() = T(std::forward<Args>(args)...);
+	}
+
+	value_type& front()
+	{
+		return buffer[first_slot & mask];
+	}
+
+	const value_type& front() const
+	{
+		return buffer[first_slot & mask];
+	}
+
+	void pop()
+	{
+		++first_slot;
+	}
+
+private:
+	value_type& next_free_slot()
+	{
+		if(full())
+			throw internal_error("static_queue overflow");
+
+		return buffer[free_slot++ & mask];
+	}
+
+private:
+	static constexpr std::size_t mask = Capacity - 1;
+
+	std::array<value_type, Capacity> buffer{};
+
+	// monotonic counters, wrapped with the mask on access
+	std::size_t free_slot = 0;
+	std::size_t first_slot = 0;
+};
+
+} // namespace genesis
+
+#endif // __STATIC_QUEUE_HPP__
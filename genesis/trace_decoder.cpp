@@ -0,0 +1,59 @@
+#include "memory/bus_trace.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+
+
+/*
+ * Prints the binary bus trace written by memory::bus_trace_recorder as text, one record per line:
+ * <cycle> <device id>: <access> at <address>, data <data>
+ *
+ * Usage: genesis_trace_decoder <trace file> [device id]
+ */
+
+using namespace genesis;
+
+
+int main(int args, char* argv[])
+{
+	if(args != 2 && args != 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " <trace file> [device id]\n";
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		std::optional<unsigned> device_id;
+		if(args == 3)
+			device_id = std::stoul(argv[2]);
+
+		memory::bus_trace_reader reader(argv[1]);
+
+		std::cout << std::uppercase << std::setfill('0');
+
+		memory::trace_record rec;
+		while(reader.next(rec))
+		{
+			if(device_id.has_value() && *device_id != rec.device_id)
+				continue;
+
+			const bool is_word = rec.access == memory::trace_access::read_word ||
+								 rec.access == memory::trace_access::write_word;
+
+			std::cout << std::dec << rec.cycle << ' ' << unsigned(rec.device_id) << ": "
+					  << memory::trace_access_name(rec.access) << " at 0x" << std::hex << std::setw(6) << rec.address
+					  << ", data 0x" << std::setw(is_word ? 4 : 2) << rec.data << '\n';
+		}
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
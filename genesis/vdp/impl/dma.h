@@ -2,6 +2,7 @@
 #define __VDP_DMA_H__
 
 #include "memory_access.h"
+#include "perf_counters.h"
 #include "vdp/m68k_bus_access.h"
 #include "vdp/register_set.h"
 #include "vdp/settings.h"
@@ -152,6 +153,7 @@ private:
 			fill_data = regs.fifo.next().data;
 
 		memory.init_write(mem_type, addr, fill_data);
+		GENESIS_PERF_ADD("vdp.dma.fill_bytes", mem_type == vmem_type::vram ? 1 : 2);
 
 		advance();
 	}
@@ -184,6 +186,7 @@ private:
 			reading = false; // memory is idle, we're not reading anymore, result should be available
 
 			memory.init_write(vmem_type::vram, regs.control.address(), memory.latched_byte());
+			GENESIS_PERF_INC("vdp.dma.vram_copy_bytes");
 			advance();
 
 			return;
@@ -230,6 +233,7 @@ private:
 
 			std::uint16_t data = m68k_bus->latched_word();
 			regs.fifo.push(data, regs.control);
+			GENESIS_PERF_ADD("vdp.dma.m68k_copy_bytes", 2);
 			inc_control_address();
 
 			// TODO: abort DMA if transfer is to CRAM/VSRAM and address exceeds max possible address
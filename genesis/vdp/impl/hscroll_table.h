@@ -69,7 +69,8 @@ private:
 		if(plane == plane_type::b)
 			address += 2;
 
-		return address;
+		// VRAM address is 16 bits wide
+		return address & 0xFFFF;
 	}
 
 private:
@@ -37,22 +37,32 @@ public:
 		m_vint_raised = false;
 	}
 
-	void cycle(int raw_v_counter, int raw_h_counter)
+	// Interrupt state can change only when HV counters change, when interrupt is acknowledged
+	// or when interrupt enable bits are written, so there is no need to check it every cycle
+
+	// must be called after HV counters are updated
+	void on_pixel(int raw_v_counter, int raw_h_counter)
 	{
-		if(m_prev_h_counter != raw_h_counter)
-		{
-			m_prev_h_counter = raw_h_counter;
+		if(m_prev_h_counter == raw_h_counter)
+			return;
 
-			auto width = m_sett.display_width();
-			auto height = m_sett.display_height();
+		m_prev_h_counter = raw_h_counter;
 
-			check_vint_flag(raw_v_counter, raw_h_counter, height);
-			check_hint_flag(raw_v_counter, raw_v_counter, height, width);
-		}
+		auto width = m_sett.display_width();
+		auto height = m_sett.display_height();
+
+		check_vint_flag(raw_v_counter, raw_h_counter, height);
+		check_hint_flag(raw_v_counter, raw_v_counter, height, width);
 
 		check_interrupts();
 	}
 
+	// must be called after any register which enables/disables interrupts is written
+	void on_register_write()
+	{
+		check_interrupts();
+	}
+
 	void on_interrupt(std::uint8_t ipl)
 	{
 		if(ipl == 6)
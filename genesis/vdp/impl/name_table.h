@@ -73,7 +73,8 @@ public:
 		std::uint32_t address =
 			m_plane_address + (m_row_size_in_bytes * row_number) + (entry_number * sizeof(name_table_entry));
 
-		return vram.read<std::uint16_t>(address);
+		// large planes (i.e. 128x64) at high base address wrap around VRAM
+		return vram.read<std::uint16_t>(address & 0xFFFF);
 	}
 
 private:
@@ -467,8 +467,9 @@ std::uint32_t render::sprite_pattern_address(unsigned row_number, unsigned sprit
 
 	unsigned sprite_pattern_number = sprite_row + (sprite_column_number * (entry.vertical_size + 1));
 
-	std::uint32_t address = entry.pattern_address + (sprite_pattern_number * 32); // each pattern is 32 bytes
-	return address;
+	// each pattern is 32 bytes, large sprites with high pattern index wrap around VRAM
+	std::uint32_t address = entry.pattern_address + (sprite_pattern_number * 32);
+	return address & 0xFFFF;
 }
 
 } // namespace genesis::vdp::impl
@@ -102,7 +102,8 @@ private:
 		if(vflip)
 			line_number = 7 - line_number;
 
-		pattern_addres += line_number * 0x4 /* single line occupies 4 bytes */;
+		// VRAM address is 16 bits wide
+		pattern_addres = (pattern_addres + line_number * 0x4 /* single line occupies 4 bytes */) & 0xFFFF;
 		std::uint32_t raw_line = vram.read_raw<std::uint32_t>(pattern_addres);
 
 		if(hflip)
@@ -50,7 +50,8 @@ public:
 		if(entry_number >= num_entries())
 			throw std::invalid_argument("entry_number");
 
-		std::uint32_t address = m_sprite_address + (entry_number * 8 /* entry size */);
+		// entries are 8-byte aligned, so the whole entry is within VRAM after wrapping
+		std::uint32_t address = (m_sprite_address + (entry_number * 8 /* entry size */)) & 0xFFFF;
 
 		sprite_table_entry entry;
 
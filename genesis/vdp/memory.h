@@ -11,10 +11,12 @@
 namespace genesis::vdp
 {
 
-class vram_t : public memory::memory_unit
+// table readers and the renderer wrap addresses to 16 bits like hardware does,
+// but port and DMA accesses are not wrapped yet, so bounds are always checked
+class vram_t : public memory::memory_unit<std::endian::big>
 {
 public:
-	vram_t() : memory::memory_unit(0xffff, std::endian::big) // [0; 0xFFFF]
+	vram_t() : memory::memory_unit<std::endian::big>(0xffff) // [0; 0xFFFF]
 	{
 	}
 };
@@ -60,7 +62,7 @@ private:
 	}
 
 private:
-	memory::memory_unit mem;
+	memory::memory_unit<> mem;
 	std::array<std::array<output_color, 16>, 4> colors;
 };
 
@@ -103,7 +105,7 @@ private:
 	}
 
 private:
-	memory::memory_unit mem;
+	memory::memory_unit<> mem;
 };
 
 }; // namespace genesis::vdp
@@ -1,5 +1,7 @@
 #include "ports.h"
 
+#include "perf_counters.h"
+
 namespace genesis::vdp
 {
 
@@ -134,6 +136,7 @@ void ports::cycle()
 		if(regs.fifo.full())
 		{
 			// wait till fifo get a free slot
+			GENESIS_PERF_INC("vdp.fifo_stalls");
 			break;
 		}
 
@@ -1,5 +1,7 @@
 #include "vdp.h"
 
+#include "perf_counters.h"
+
 #include <iostream>
 
 namespace genesis::vdp
@@ -59,8 +61,10 @@ void vdp::cycle()
 	mclk++;
 
 	if(mclk % (cycles_per_pixel(_sett) * 2) == 0)
+	{
 		m_hv_unit.on_pixel(_sett.display_width(), _sett.display_height(), MODE);
-	m_int_unit.cycle(m_hv_unit.v_counter_raw(), m_hv_unit.h_counter_raw());
+		m_int_unit.on_pixel(m_hv_unit.v_counter_raw(), m_hv_unit.h_counter_raw());
+	}
 
 	if(mclk == 1)
 	{
@@ -95,6 +99,10 @@ void vdp::handle_ports_requests()
 			if(reg_num <= 23)
 			{
 				regs.set_register(reg_num, reg_data);
+
+				// R0/R1 contain interrupt enable bits
+				if(reg_num <= 1)
+					m_int_unit.on_register_write();
 			}
 		}
 		else
@@ -273,6 +281,8 @@ void vdp::on_end_scanline()
 	int vint_threshold = _sett.display_height() == display_height::c28 ? 0xE0 : 0xF0;
 	if(regs.v_counter == vint_threshold)
 	{
+		GENESIS_PERF_INC("vdp.frames");
+
 		if(on_frame_end_callback != nullptr)
 			on_frame_end_callback();
 	}
@@ -1,6 +1,7 @@
 #include "cpu.h"
 
 #include "impl/executioner.hpp"
+#include "memory/watching_memory.h"
 #include "string_utils.hpp"
 
 
@@ -30,4 +31,51 @@ void cpu::execute_one()
 	exec->execute_one();
 }
 
+void cpu::add_breakpoint(break_type type, std::uint16_t address)
+{
+	m_breakpoints.add(type, address);
+	update_breakpoints();
+}
+
+void cpu::remove_breakpoint(break_type type, std::uint16_t address)
+{
+	m_breakpoints.remove(type, address);
+	update_breakpoints();
+}
+
+void cpu::clear_breakpoints()
+{
+	m_breakpoints.clear();
+	update_breakpoints();
+}
+
+void cpu::on_break(break_handler handler)
+{
+	m_breakpoints.on_break(std::move(handler));
+}
+
+void cpu::update_breakpoints()
+{
+	// instrument execution/memory access only while they have breakpoints
+	if(m_breakpoints.empty(break_type::execution))
+		exec->set_breakpoint_check(nullptr);
+	else
+		exec->set_breakpoint_check([this](std::uint16_t pc) { return m_breakpoints.check_execution(pc); });
+
+	const bool watching = m_unwatched_memory != nullptr;
+	if(m_breakpoints.has_watchpoints() && !watching)
+	{
+		m_unwatched_memory = mem->get_addressable();
+		mem->set_addressable(
+			std::make_shared<genesis::memory::watching_memory<z80::breakpoints>>(m_unwatched_memory, m_breakpoints));
+		mem->suspend_direct_ram(true);
+	}
+	else if(!m_breakpoints.has_watchpoints() && watching)
+	{
+		mem->set_addressable(std::move(m_unwatched_memory));
+		m_unwatched_memory = nullptr;
+		mem->suspend_direct_ram(false);
+	}
+}
+
 } // namespace genesis::z80
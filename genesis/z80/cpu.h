@@ -1,6 +1,7 @@
 #ifndef __Z80_CPU_H__
 #define __Z80_CPU_H__
 
+#include "breakpoints.hpp"
 #include "cpu_bus.hpp"
 #include "cpu_registers.hpp"
 #include "io_ports.hpp"
@@ -26,6 +27,9 @@ enum class cpu_interrupt_mode
 
 class executioner;
 
+// one bit per byte of 16-bit address space
+using breakpoints = genesis::breakpoints<16, 0>;
+
 class cpu
 {
 public:
@@ -38,6 +42,7 @@ public:
 
 	cpu_registers& registers()
 	{
+		regs.sync_flags();
 		return regs;
 	}
 
@@ -72,6 +77,17 @@ public:
 
 	void reset();
 
+	// Breakpoints are checked only while at least one of them is set.
+	// When execution breakpoint is hit execute_one returns without executing the instruction,
+	// the instruction is executed once execute_one is called again.
+	void add_breakpoint(break_type type, std::uint16_t address);
+	void remove_breakpoint(break_type type, std::uint16_t address);
+	void clear_breakpoints();
+	void on_break(break_handler handler);
+
+private:
+	void update_breakpoints();
+
 private:
 	std::unique_ptr<z80::executioner> exec;
 	std::shared_ptr<z80::memory> mem;
@@ -79,6 +95,9 @@ private:
 	cpu_registers regs;
 	cpu_bus _bus;
 	cpu_interrupt_mode int_mode;
+
+	z80::breakpoints m_breakpoints;
+	std::shared_ptr<genesis::memory::addressable> m_unwatched_memory;
 };
 
 } // namespace genesis::z80
@@ -1,6 +1,8 @@
 #ifndef __Z80_CPU_REGISTERS_HPP__
 #define __Z80_CPU_REGISTERS_HPP__
 
+#include "cpu_flags.hpp"
+
 #include <bit>
 #include <cstdint>
 
@@ -28,6 +30,30 @@ struct flags
 static_assert(sizeof(flags) == 1);
 
 
+// Operations which flags evaluation can be deferred
+enum class flags_op : std::uint8_t
+{
+	none,
+	add, // ADD/ADC
+	sub, // SUB/SBC
+	cp,	 // same as sub but Y/X are taken from the operand
+	and_8,
+	or_8, // OR/XOR
+	inc,
+	dec,
+};
+
+// Inputs of the last operation with deferred flags evaluation
+struct deferred_flags
+{
+	flags_op op = flags_op::none;
+	std::uint8_t a;
+	std::uint8_t b;
+	std::uint8_t c;
+	std::uint8_t res;
+};
+
+
 class register_set
 {
 private:
@@ -167,6 +193,88 @@ public:
 
 	std::uint8_t IFF1 : 1;
 	std::uint8_t IFF2 : 1;
+
+	/* Deferred flags evaluation */
+
+	void defer_flags(flags_op op, std::uint8_t a, std::uint8_t b, std::uint8_t c, std::uint8_t res)
+	{
+		// INC/DEC do not affect C, so it must be evaluated first
+		if(pending.op != flags_op::none && (op == flags_op::inc || op == flags_op::dec))
+			sync_flags();
+
+		pending = {op, a, b, c, res};
+	}
+
+	bool flags_deferred() const
+	{
+		return pending.op != flags_op::none;
+	}
+
+	// evaluate deferred flags, must be called before reading/modifying F
+	void sync_flags()
+	{
+		if(pending.op == flags_op::none)
+			return;
+
+		auto& flags = main_set.flags;
+		const std::uint8_t a = pending.a;
+		const std::uint8_t b = pending.b;
+		const std::uint8_t c = pending.c;
+		const std::uint8_t res = pending.res;
+
+		switch(pending.op)
+		{
+		case flags_op::add:
+			flags.H = ((a & 0xF) + (b & 0xF) + c) > 0xF;
+			flags.PV = cpu_flags::overflow_add<std::int8_t>(a, b, c);
+			flags.C = cpu_flags::carry<std::uint8_t>(a, b, c);
+			flags.N = 0;
+			break;
+
+		case flags_op::sub:
+		case flags_op::cp:
+			flags.H = ((b & 0xF) + c) > (a & 0xF);
+			flags.PV = cpu_flags::overflow_sub<std::int8_t>(a, b, c);
+			flags.C = cpu_flags::borrow<std::uint8_t>(a, b, c);
+			flags.N = 1;
+			break;
+
+		case flags_op::and_8:
+		case flags_op::or_8:
+			flags.H = pending.op == flags_op::and_8;
+			flags.N = flags.C = 0;
+			flags.PV = (std::popcount(res) % 2) == 0;
+			break;
+
+		case flags_op::inc:
+			flags.N = 0;
+			flags.PV = a == 0x7F;
+			flags.H = (a & 0xF) == 0xF;
+			break;
+
+		case flags_op::dec:
+			flags.N = 1;
+			flags.PV = a == 0x80;
+			flags.H = (a & 0xF) == 0;
+			break;
+
+		default:
+			break;
+		}
+
+		flags.S = res >> 7;
+		flags.Z = res == 0;
+
+		// CP takes undocumented flags from the operand
+		const std::uint8_t yx = pending.op == flags_op::cp ? b : res;
+		flags.X = (yx >> 3) & 1;
+		flags.Y = (yx >> 5) & 1;
+
+		pending.op = flags_op::none;
+	}
+
+private:
+	deferred_flags pending;
 };
 
 } // namespace genesis::z80
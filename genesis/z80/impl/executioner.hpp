@@ -5,9 +5,13 @@
 #include "inst_finder.hpp"
 #include "instructions.hpp"
 #include "operations.hpp"
+#include "perf_counters.h"
 #include "string_utils.hpp"
 #include "z80/cpu.h"
 
+#include <array>
+#include <functional>
+
 
 namespace genesis::z80
 {
@@ -15,7 +19,8 @@ namespace genesis::z80
 class executioner
 {
 public:
-	executioner(z80::cpu& cpu) : cpu(cpu), dec(z80::decoder(cpu)), ops(z80::operations(cpu))
+	executioner(z80::cpu& cpu)
+		: cpu(cpu), mem(cpu.memory()), regs(cpu.registers()), dec(z80::decoder(cpu)), ops(z80::operations(cpu))
 	{
 	}
 
@@ -49,28 +54,31 @@ public:
 			return;
 		}
 
-		auto& mem = cpu.memory();
-		auto& regs = cpu.registers();
+		interrupts_just_enabled = false;
 
+		// every opcode has its own handler with addressing modes resolved at build time
 		z80::opcode opcode = mem.read<z80::opcode>(regs.PC);
-		z80::opcode opcode2 = mem.read<z80::opcode>(regs.PC + 1);
+		(this->*(*m_base_handlers)[opcode])();
 
-		auto inst = finder.fast_search(opcode, opcode2);
-		exec_and_advance(inst);
+		GENESIS_PERF_INC("z80.instructions");
 	}
 
-private:
-	void exec_and_advance(z80::instruction inst)
+	// check is called with the address of every instruction before it's executed,
+	// returning true skips execution for the current call
+	void set_breakpoint_check(std::function<bool(std::uint16_t)> check)
 	{
-		exec(inst);
-		if(need_advance_pc(inst.op_type))
-			dec.advance_pc(inst);
+		m_break_check = std::move(check);
+		m_base_handlers = m_break_check ? &breakpoint_handlers : &base_handlers;
 	}
 
+private:
 	void exec(z80::instruction inst)
 	{
 		interrupts_just_enabled = false;
 
+		if(regs.flags_deferred() && !keeps_flags_deferred(inst.op_type))
+			regs.sync_flags();
+
 		switch(inst.op_type)
 		{
 		/* 8-Bit Arithmetic Group */
@@ -472,41 +480,6 @@ private:
 		}
 	}
 
-	// TODO: move to decoder?
-	bool need_advance_pc(operation_type op)
-	{
-		switch(op)
-		{
-		// these control PC itslef
-		case operation_type::call:
-		case operation_type::call_cc:
-		case operation_type::rst:
-		case operation_type::ret:
-		case operation_type::reti:
-		case operation_type::retn:
-		case operation_type::ret_cc:
-		case operation_type::jp:
-		case operation_type::jp_cc:
-		case operation_type::jr:
-		case operation_type::jr_z:
-		case operation_type::jr_nz:
-		case operation_type::jr_c:
-		case operation_type::jr_nc:
-		case operation_type::ldir:
-		case operation_type::cpdr:
-		case operation_type::cpir:
-		case operation_type::lddr:
-		case operation_type::djnz:
-		case operation_type::inir:
-		case operation_type::indr:
-		case operation_type::otir:
-		case operation_type::otdr:
-			return false;
-		default:
-			return true;
-		}
-	}
-
 	bool check_interrupts()
 	{
 		auto& bus = cpu.bus();
@@ -532,7 +505,7 @@ private:
 			return false;
 		}
 
-		if(cpu.registers().IFF1 == 0)
+		if(regs.IFF1 == 0)
 		{
 			// maskable interrupts are disabled
 			return false;
@@ -570,12 +543,38 @@ private:
 		}
 	}
 
+private:
+	using handler = void (executioner::*)();
+
+	// specialised handlers and dispatch tables generated by z80/impl/gen/exec_generator.cpp
+#include "z80/impl/exec_handlers.inc"
+
+	void exec_breakpoint()
+	{
+		if(m_break_check(regs.PC))
+			return;
+
+		(this->*base_handler(mem.read<z80::opcode>(regs.PC)))();
+	}
+
+	// dispatch table used while execution breakpoints are set
+	static constexpr std::array<handler, 0x100> breakpoint_handlers = []() {
+		std::array<handler, 0x100> res;
+		res.fill(&executioner::exec_breakpoint);
+		return res;
+	}();
+
 private:
 	z80::cpu& cpu;
+	z80::memory& mem;
+	z80::cpu_registers& regs;
 	z80::decoder dec;
 	z80::operations ops;
 	z80::inst_finder finder;
 	bool interrupts_just_enabled = false;
+
+	const std::array<handler, 0x100>* m_base_handlers = &base_handlers;
+	std::function<bool(std::uint16_t)> m_break_check;
 };
 
 } // namespace genesis::z80
@@ -1,312 +1,694 @@
-#include "helpers.h"
-
-#include <iostream>
-#include <functional>
-
-using namespace genesis::z80;
-
-class inline_decodern
-{
-	const char* decode_byte(addressing_mode);
-	const char* decode_reg_8(addressing_mode);
-};
-
-// get_operation_call
-const char* get_op_handler(genesis::z80::operation_type op/*source, destenation*/)
-{
-	using namespace genesis::z80;
-	switch (op)
-	{
-	case operation_type::add:
-		return "ops.add(dec.decode_byte(inst.source, inst));";
-	case operation_type::adc:
-		return "ops.adc(dec.decode_byte(inst.source, inst));";
-	case operation_type::sub:
-		return "ops.sub(dec.decode_byte(inst.source, inst));";
-	case operation_type::sbc:
-		return "ops.sbc(dec.decode_byte(inst.source, inst));";
-	case operation_type::and_8:
-		return "ops.and_8(dec.decode_byte(inst.source, inst));";
-	case operation_type::or_8:
-		return "ops.or_8(dec.decode_byte(inst.source, inst));";
-	case operation_type::xor_8:
-		return "ops.xor_8(dec.decode_byte(inst.source, inst));";
-	case operation_type::cp:
-		return "ops.cp(dec.decode_byte(inst.source, inst));";
-	case operation_type::inc_reg:
-		return "ops.inc_reg(dec.decode_reg_8(inst.source));";
-	case operation_type::dec_reg:
-		return "ops.dec_reg(dec.decode_reg_8(inst.source));";
-	case operation_type::inc_at:
-		return "ops.inc_at(dec.decode_address(inst.source, inst));";
-	case operation_type::dec_at:
-		return "ops.dec_at(dec.decode_address(inst.source, inst));";
-	case operation_type::add_16:
-		return "ops.add_16(dec.decode_reg_16(inst.source), dec.decode_reg_16(inst.destination));";
-	case operation_type::adc_hl:
-		return "ops.adc_hl(dec.decode_reg_16(inst.source));";
-	case operation_type::sbc_hl:
-		return "ops.sbc_hl(dec.decode_reg_16(inst.source));";
-	case operation_type::inc_reg_16:
-		return "ops.inc_reg_16(dec.decode_reg_16(inst.source));";
-	case operation_type::dec_reg_16:
-		return "ops.dec_reg_16(dec.decode_reg_16(inst.source));";
-	case operation_type::ld_reg:
-		return "ops.ld_reg(dec.decode_byte(inst.source, inst), dec.decode_reg_8(inst.destination));";
-	case operation_type::ld_at:
-		return "ops.ld_at(dec.decode_byte(inst.source, inst), dec.decode_address(inst.destination, inst));";
-	case operation_type::ld_16_at:
-		return "ops.ld_at(dec.decode_2_bytes(inst.source, inst), dec.decode_address(inst.destination, inst));";
-	case operation_type::ld_ir:
-		return "ops.ld_ir(dec.decode_reg_8(inst.source));";
-	case operation_type::ld_16_reg:
-		return "ops.ld_reg(dec.decode_2_bytes(inst.source, inst), dec.decode_reg_16(inst.destination));";
-	case operation_type::ld_16_reg_from:
-		return "ops.ld_reg_from(dec.decode_reg_16(inst.destination), dec.decode_address(inst.source, inst));";
-	case operation_type::push:
-		return "ops.push(dec.decode_reg_16(inst.source));";
-	case operation_type::pop:
-		return "ops.pop(dec.decode_reg_16(inst.destination));";
-	case operation_type::call:
-		return "ops.call(dec.decode_address(inst.source, inst));";
-	case operation_type::call_cc:
-		return "ops.call_cc(dec.decode_cc(inst), dec.decode_address(inst.source, inst));";
-	case operation_type::rst:
-		return "ops.rst(dec.decode_cc(inst));";
-	case operation_type::ret:
-		return "ops.ret();";
-	case operation_type::ret_cc:
-		return "ops.ret_cc(dec.decode_cc(inst));";
-	case operation_type::jp:
-		return "ops.jp(dec.decode_address(inst.source, inst));";
-	case operation_type::jp_cc:
-		return "ops.jp_cc(dec.decode_cc(inst), dec.decode_address(inst.source, inst));";
-	case operation_type::jr:
-		return "ops.jr(dec.decode_byte(inst.source, inst));";
-	case operation_type::jr_z:
-		return "ops.jr_z(dec.decode_byte(inst.source, inst));";
-	case operation_type::jr_nz:
-		return "ops.jr_nz(dec.decode_byte(inst.source, inst));";
-	case operation_type::jr_c:
-		return "ops.jr_c(dec.decode_byte(inst.source, inst));";
-	case operation_type::jr_nc:
-		return "ops.jr_nc(dec.decode_byte(inst.source, inst));";
-	case operation_type::di:
-		return "ops.di();";
-	case operation_type::ei:
-		return "ops.ei();";
-	case operation_type::nop:
-		return "";
-	case operation_type::out:
-		return "ops.out(dec.decode_byte(inst.source, inst));";
-	case operation_type::ex_de_hl:
-		return "ops.ex_de_hl();";
-	case operation_type::ex_af_afs:
-		return "ops.ex_af_afs();";
-	case operation_type::exx:
-		return "ops.exx();";
-	case operation_type::ldi:
-		return "ops.ldi();";
-	case operation_type::ldir:
-		return "ops.ldir();";
-	case operation_type::cpd:
-		return "ops.cpd();";
-	case operation_type::cpdr:
-		return "ops.cpdr();";
-	case operation_type::cpi:
-		return "ops.cpi();";
-	case operation_type::cpir:
-		return "ops.cpir();";
-	case operation_type::ldd:
-		return "ops.ldd();";
-	case operation_type::lddr:
-		return "ops.lddr();";
-	case operation_type::rlca:
-		return "ops.rlca();";
-	case operation_type::rrca:
-		return "ops.rrca();";
-	case operation_type::rla:
-		return "ops.rla();";
-	case operation_type::rra:
-		return "ops.rra();";
-	case operation_type::rld:
-		return "ops.rld();";
-	case operation_type::rrd:
-		return "ops.rrd();";
-	case operation_type::rlc:
-		return "ops.rlc(dec.decode_reg_8(inst.destination));";
-	case operation_type::rlc_at:
-		return "ops.rlc_at(dec.decode_address(inst.destination, inst));";
-	case operation_type::rrc:
-		return "ops.rrc(dec.decode_reg_8(inst.destination));";
-	case operation_type::rrc_at:
-		return "ops.rrc_at(dec.decode_address(inst.destination, inst));";
-	case operation_type::rl:
-		return "ops.rl(dec.decode_reg_8(inst.destination));";
-	case operation_type::rl_at:
-		return "ops.rl_at(dec.decode_address(inst.destination, inst));";
-	case operation_type::rr:
-		return "ops.rr(dec.decode_reg_8(inst.destination));";
-	case operation_type::rr_at:
-		return "ops.rr_at(dec.decode_address(inst.destination, inst));";
-	case operation_type::sla:
-		return "ops.sla(dec.decode_reg_8(inst.destination));";
-	case operation_type::sla_at:
-		return "ops.sla_at(dec.decode_address(inst.destination, inst));";
-	case operation_type::sra:
-		return "ops.sra(dec.decode_reg_8(inst.destination));";
-	case operation_type::sra_at:
-		return "ops.sra_at(dec.decode_address(inst.destination, inst));";
-	case operation_type::srl:
-		return "ops.srl(dec.decode_reg_8(inst.destination));";
-	case operation_type::srl_at:
-		return "ops.srl_at(dec.decode_address(inst.destination, inst));";
-	case operation_type::sll:
-		return "ops.sll(dec.decode_reg_8(inst.destination));";
-	case operation_type::sll_at:
-		return "ops.sll_at(dec.decode_address(inst.destination, inst));";
-	case operation_type::tst_bit:
-		return "ops.tst_bit(dec.decode_byte(inst.destination, inst), dec.decode_bit(inst.source, inst));";
-	case operation_type::tst_bit_at:
-		return "ops.tst_bit_at(dec.decode_address(inst.destination, inst), dec.decode_bit(inst.source, inst));";
-	case operation_type::set_bit:
-		return "ops.set_bit(dec.decode_reg_8(inst.destination), dec.decode_bit(inst.source, inst));";
-	case operation_type::set_bit_at:
-		return "ops.set_bit_at(dec.decode_address(inst.destination, inst), dec.decode_bit(inst.source, inst));";
-	case operation_type::res_bit:
-		return "ops.res_bit(dec.decode_reg_8(inst.destination), dec.decode_bit(inst.source, inst));";
-	case operation_type::res_bit_at:
-		return "ops.res_bit_at(dec.decode_address(inst.destination, inst), dec.decode_bit(inst.source, inst));";
-	case operation_type::bit_group:
-		return "exec_bit_group(inst);";
-	case operation_type::daa:
-		return "ops.daa();";
-	case operation_type::cpl:
-		return "ops.cpl();";
-	case operation_type::neg:
-		return "ops.neg();";
-	case operation_type::ccf:
-		return "ops.ccf();";
-	case operation_type::scf:
-		return "ops.scf();";
-
-	default:
-		throw std::runtime_error("get_exec_op unsupporeted operatoin_type!");
-	}
-}
-
-bool need_advance_pc(operation_type op)
-{
-	switch (op)
-	{
-	// these control PC itslef
-	case operation_type::call:
-	case operation_type::call_cc:
-	case operation_type::rst:
-	case operation_type::ret:
-	case operation_type::ret_cc:
-	case operation_type::jp:
-	case operation_type::jp_cc:
-	case operation_type::jr:
-	case operation_type::jr_z:
-	case operation_type::jr_nz:
-	case operation_type::jr_c:
-	case operation_type::jr_nc:
-	case operation_type::ldir:
-	case operation_type::cpdr:
-	case operation_type::cpir:
-	case operation_type::lddr:
-	case operation_type::djnz:
-		return false;
-	default:
-		return true;
-	}
-}
-
-void print_break_or_return(operation_type op)
-{
-	if(need_advance_pc(op))
-	{
-		std::cout << "\t" << "break;" << std::endl;
-	}
-	else
-	{
-		std::cout << "\t" << "return;" << std::endl;
-	}
-}
-
-void print_op_handler(operation_type op)
-{
-	std::cout << "\t" << get_op_handler(op) << std::endl;
-	print_break_or_return(op);
-}
-
-void print_case_opcode(std::uint8_t op)
-{
-	std::cout << "case " << su::hex_str(op) << ":" << std::endl;
-}
-
-void print_group(const std::vector<instruction>& insts, std::uint8_t op_group = 0x0)
-{
-	if(op_group != 0x0)
-	{
-		print_case_opcode(op_group);
-		std::cout << "{" << std::endl;
-		std::cout << "switch (op2) {" << std::endl;
-	}
-
-	for(auto inst: insts)
-	{
-		std::uint8_t opcode = inst.opcodes[0];
-
-		if(op_group != 0x0)
-		{
-			if(inst.opcodes[0] != op_group)
-				continue;
-
-			opcode = inst.opcodes[1];
-		}
-		else
-		{
-			if(long_instruction(opcode))
-				continue;
-		}
-
-		print_case_opcode(opcode);
-		print_op_handler(inst.op_type);
-	}
-
-	if(op_group != 0x0)
-	{
-		std::cout << "}" << std::endl;
-		std::cout << "break;" << std::endl;
-		std::cout << "}" << std::endl;
-	}
-}
-
-// g++ -std=c++20 -I../../../ exec_generator.cpp -o exec_generator
-int main()
-{
-	std::vector<instruction> insts (std::cbegin(instructions), std::cend(instructions));
-	std::sort(insts.begin(), insts.end(), [](instruction a, instruction b)
-	{
-		std::uint8_t o1 = a.opcodes[0];
-		std::uint8_t o2 = b.opcodes[0];
-		if(o1 == o2)
-		{
-			o1 = a.opcodes[1];
-			o2 = b.opcodes[1];
-		}
-		
-		return o1 < o2;
-	});
-
-	
-	print_group(insts);
-	print_group(insts, 0xDD);
-	print_group(insts, 0xFD);
-	print_group(insts, 0xCB);
-	print_group(insts, 0xED);
-
-	return EXIT_SUCCESS;
-}
+/*
+ * Generates a specialised handler for every z80 opcode and a dispatch table per opcode prefix
+ * (base, CB, DD, FD, ED, DDCB, FDCB).
+ *
+ * Addressing modes are resolved at generation time, so handlers access registers/memory directly
+ * instead of going through decoder switches. The output is included into executioner class body.
+ *
+ * Usage: exec_generator <output file>
+ */
+
+#include "helpers.hpp"
+#include "string_utils.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+
+using namespace genesis;
+using namespace genesis::z80;
+
+
+enum class prefix
+{
+	base,
+	cb,
+	dd,
+	fd,
+	ed,
+	ddcb,
+	fdcb,
+};
+
+std::string prefix_str(prefix pref)
+{
+	switch(pref)
+	{
+	case prefix::base:
+		return "base";
+	case prefix::cb:
+		return "cb";
+	case prefix::dd:
+		return "dd";
+	case prefix::fd:
+		return "fd";
+	case prefix::ed:
+		return "ed";
+	case prefix::ddcb:
+		return "ddcb";
+	case prefix::fdcb:
+		return "fdcb";
+	default:
+		throw std::runtime_error("prefix_str: unsupported prefix");
+	}
+}
+
+std::string hex(std::uint8_t val)
+{
+	return su::hex_str(val).substr(2);
+}
+
+std::string handler_name(prefix pref, std::uint8_t opcode)
+{
+	return "exec_" + prefix_str(pref) + "_" + hex(opcode);
+}
+
+/* operand decoding, mirrors z80::decoder */
+
+std::uint8_t inst_size(const instruction& inst)
+{
+	return long_instruction(inst.opcodes[0]) ? 2 : 1;
+}
+
+std::uint8_t operand_size(addressing_mode addr_mode)
+{
+	switch(addr_mode)
+	{
+	case addressing_mode::immediate:
+	case addressing_mode::indexed_ix:
+	case addressing_mode::indexed_iy:
+	case addressing_mode::immediate_bit:
+		return 1;
+	case addressing_mode::immediate_ext:
+		return 2;
+	default:
+		return 0;
+	}
+}
+
+bool is_indexed(addressing_mode addr_mode)
+{
+	return addr_mode == addressing_mode::indexed_ix || addr_mode == addressing_mode::indexed_iy;
+}
+
+[[noreturn]] void unsupported(addressing_mode addr_mode)
+{
+	throw std::runtime_error("unsupported addressing mode " + std::to_string(addr_mode));
+}
+
+std::string reg_8(addressing_mode addr_mode)
+{
+	switch(addr_mode)
+	{
+	case addressing_mode::register_a:
+		return "regs.main_set.A";
+	case addressing_mode::register_b:
+		return "regs.main_set.B";
+	case addressing_mode::register_c:
+		return "regs.main_set.C";
+	case addressing_mode::register_d:
+		return "regs.main_set.D";
+	case addressing_mode::register_e:
+		return "regs.main_set.E";
+	case addressing_mode::register_h:
+		return "regs.main_set.H";
+	case addressing_mode::register_l:
+		return "regs.main_set.L";
+	case addressing_mode::register_i:
+		return "regs.I";
+	case addressing_mode::register_r:
+		return "regs.R";
+	case addressing_mode::register_ixh:
+		return "regs.IXH";
+	case addressing_mode::register_ixl:
+		return "regs.IXL";
+	case addressing_mode::register_iyh:
+		return "regs.IYH";
+	case addressing_mode::register_iyl:
+		return "regs.IYL";
+	default:
+		unsupported(addr_mode);
+	}
+}
+
+std::string reg_16(addressing_mode addr_mode)
+{
+	switch(addr_mode)
+	{
+	case addressing_mode::register_af:
+		return "regs.main_set.AF";
+	case addressing_mode::register_bc:
+		return "regs.main_set.BC";
+	case addressing_mode::register_de:
+		return "regs.main_set.DE";
+	case addressing_mode::register_hl:
+		return "regs.main_set.HL";
+	case addressing_mode::register_sp:
+		return "regs.SP";
+	case addressing_mode::register_ix:
+		return "regs.IX";
+	case addressing_mode::register_iy:
+		return "regs.IY";
+	default:
+		unsupported(addr_mode);
+	}
+}
+
+std::string imm_operand(std::string type, const instruction& inst)
+{
+	int offset = inst_size(inst);
+
+	// displacement of indexed addressing mode goes before immediate operand
+	if(is_indexed(inst.source) || is_indexed(inst.destination))
+		offset += 1;
+
+	return "mem.read<" + type + ">(regs.PC + " + std::to_string(offset) + ")";
+}
+
+std::string indexed(addressing_mode addr_mode)
+{
+	std::string base = addr_mode == addressing_mode::indexed_ix ? "regs.IX" : "regs.IY";
+	return "z80::memory::address(z80::memory::address(" + base + ") + mem.read<std::int8_t>(regs.PC + 2))";
+}
+
+std::string address(addressing_mode addr_mode, const instruction& inst)
+{
+	switch(addr_mode)
+	{
+	case addressing_mode::immediate_ext:
+		return "z80::memory::address(" + imm_operand("std::int16_t", inst) + ")";
+	case addressing_mode::indirect_hl:
+		return "z80::memory::address(regs.main_set.HL)";
+	case addressing_mode::indirect_bc:
+		return "z80::memory::address(regs.main_set.BC)";
+	case addressing_mode::indirect_de:
+		return "z80::memory::address(regs.main_set.DE)";
+	case addressing_mode::indirect_sp:
+		return "z80::memory::address(regs.SP)";
+	case addressing_mode::indexed_ix:
+	case addressing_mode::indexed_iy:
+		return indexed(addr_mode);
+	default:
+		unsupported(addr_mode);
+	}
+}
+
+std::string byte(addressing_mode addr_mode, const instruction& inst)
+{
+	switch(addr_mode)
+	{
+	case addressing_mode::register_a:
+	case addressing_mode::register_b:
+	case addressing_mode::register_c:
+	case addressing_mode::register_d:
+	case addressing_mode::register_e:
+	case addressing_mode::register_h:
+	case addressing_mode::register_l:
+	case addressing_mode::register_i:
+	case addressing_mode::register_r:
+	case addressing_mode::register_ixh:
+	case addressing_mode::register_ixl:
+	case addressing_mode::register_iyh:
+	case addressing_mode::register_iyl:
+		return reg_8(addr_mode);
+	case addressing_mode::immediate:
+		return imm_operand("std::int8_t", inst);
+	default:
+		return "mem.read<std::int8_t>(" + address(addr_mode, inst) + ")";
+	}
+}
+
+std::string two_bytes(addressing_mode addr_mode, const instruction& inst)
+{
+	if(addr_mode == addressing_mode::immediate_ext)
+		return imm_operand("std::int16_t", inst);
+	return reg_16(addr_mode);
+}
+
+std::string cc(const instruction& inst)
+{
+	return std::to_string((inst.opcodes[0] & 0b00111000) >> 3);
+}
+
+std::string bit_operand(const instruction& inst)
+{
+	if(inst.source != addressing_mode::bit)
+		unsupported(inst.source);
+	return std::to_string((inst.opcodes[1] & 0b00111000) >> 3);
+}
+
+/* operation calls, mirror executioner::exec */
+
+std::string op_call(const instruction& inst)
+{
+	const auto src = inst.source;
+	const auto dest = inst.destination;
+
+	switch(inst.op_type)
+	{
+	case operation_type::add:
+		return "ops.add(" + byte(src, inst) + ");";
+	case operation_type::adc:
+		return "ops.adc(" + byte(src, inst) + ");";
+	case operation_type::sub:
+		return "ops.sub(" + byte(src, inst) + ");";
+	case operation_type::sbc:
+		return "ops.sbc(" + byte(src, inst) + ");";
+	case operation_type::and_8:
+		return "ops.and_8(" + byte(src, inst) + ");";
+	case operation_type::or_8:
+		return "ops.or_8(" + byte(src, inst) + ");";
+	case operation_type::xor_8:
+		return "ops.xor_8(" + byte(src, inst) + ");";
+	case operation_type::cp:
+		return "ops.cp(" + byte(src, inst) + ");";
+	case operation_type::inc_reg:
+		return "ops.inc_reg(" + reg_8(src) + ");";
+	case operation_type::dec_reg:
+		return "ops.dec_reg(" + reg_8(src) + ");";
+	case operation_type::inc_at:
+		return "ops.inc_at(" + address(src, inst) + ");";
+	case operation_type::dec_at:
+		return "ops.dec_at(" + address(src, inst) + ");";
+
+	case operation_type::add_16:
+		return "ops.add_16(" + reg_16(src) + ", " + reg_16(dest) + ");";
+	case operation_type::adc_hl:
+		return "ops.adc_hl(" + reg_16(src) + ");";
+	case operation_type::sbc_hl:
+		return "ops.sbc_hl(" + reg_16(src) + ");";
+	case operation_type::inc_reg_16:
+		return "ops.inc_reg_16(" + reg_16(src) + ");";
+	case operation_type::dec_reg_16:
+		return "ops.dec_reg_16(" + reg_16(src) + ");";
+
+	case operation_type::ld_reg:
+		return "ops.ld_reg<std::int8_t>(" + byte(src, inst) + ", " + reg_8(dest) + ");";
+	case operation_type::ld_at:
+		return "ops.ld_at<std::int8_t>(" + byte(src, inst) + ", " + address(dest, inst) + ");";
+	case operation_type::ld_16_at:
+		return "ops.ld_at<std::int16_t>(" + two_bytes(src, inst) + ", " + address(dest, inst) + ");";
+	case operation_type::ld_ir:
+		return "ops.ld_ir(" + reg_8(src) + ");";
+	case operation_type::ld_16_reg:
+		return "ops.ld_reg<std::int16_t>(" + two_bytes(src, inst) + ", " + reg_16(dest) + ");";
+	case operation_type::ld_16_reg_from:
+		return "ops.ld_reg_from(" + reg_16(dest) + ", " + address(src, inst) + ");";
+	case operation_type::push:
+		return "ops.push(" + reg_16(src) + ");";
+	case operation_type::pop:
+		return "ops.pop(" + reg_16(dest) + ");";
+
+	case operation_type::call:
+		return "ops.call(" + address(src, inst) + ");";
+	case operation_type::call_cc:
+		return "ops.call_cc(" + cc(inst) + ", " + address(src, inst) + ");";
+	case operation_type::rst:
+		return "ops.rst(" + cc(inst) + ");";
+	case operation_type::ret:
+		return "ops.ret();";
+	case operation_type::reti:
+		return "ops.reti();";
+	case operation_type::retn:
+		return "ops.retn();";
+	case operation_type::ret_cc:
+		return "ops.ret_cc(" + cc(inst) + ");";
+
+	case operation_type::jp:
+		return "ops.jp(" + two_bytes(src, inst) + ");";
+	case operation_type::jp_cc:
+		return "ops.jp_cc(" + cc(inst) + ", " + address(src, inst) + ");";
+	case operation_type::jr:
+		return "ops.jr(" + byte(src, inst) + ");";
+	case operation_type::jr_z:
+		return "ops.jr_z(" + byte(src, inst) + ");";
+	case operation_type::jr_nz:
+		return "ops.jr_nz(" + byte(src, inst) + ");";
+	case operation_type::jr_c:
+		return "ops.jr_c(" + byte(src, inst) + ");";
+	case operation_type::jr_nc:
+		return "ops.jr_nc(" + byte(src, inst) + ");";
+	case operation_type::djnz:
+		return "ops.djnz(" + byte(src, inst) + ");";
+
+	case operation_type::nop:
+		return "";
+	case operation_type::halt:
+		return "ops.halt();";
+	case operation_type::di:
+		return "ops.di();";
+	case operation_type::ei:
+		return "ops.ei();\n\tinterrupts_just_enabled = true;";
+	case operation_type::im0:
+		return "ops.im0();";
+	case operation_type::im1:
+		return "ops.im1();";
+	case operation_type::im2:
+		return "ops.im2();";
+
+	case operation_type::in:
+		return "ops.in(" + byte(src, inst) + ");";
+	case operation_type::in_reg:
+		return "ops.in_reg(" + reg_8(dest) + ");";
+	case operation_type::in_c:
+		return "ops.in_c();";
+	case operation_type::ini:
+		return "ops.ini();";
+	case operation_type::inir:
+		return "ops.inir();";
+	case operation_type::ind:
+		return "ops.ind();";
+	case operation_type::indr:
+		return "ops.indr();";
+	case operation_type::out:
+		return "ops.out(" + byte(src, inst) + ");";
+	case operation_type::out_reg:
+		return "ops.out_reg(" + reg_8(src) + ");";
+	case operation_type::outi:
+		return "ops.outi();";
+	case operation_type::otir:
+		return "ops.otir();";
+	case operation_type::outd:
+		return "ops.outd();";
+	case operation_type::otdr:
+		return "ops.otdr();";
+
+	case operation_type::ex_de_hl:
+		return "ops.ex_de_hl();";
+	case operation_type::ex_af_afs:
+		return "ops.ex_af_afs();";
+	case operation_type::exx:
+		return "ops.exx();";
+	case operation_type::ex_16_at:
+		return "ops.ex_16_at(" + reg_16(src) + ", " + address(dest, inst) + ");";
+	case operation_type::ldi:
+		return "ops.ldi();";
+	case operation_type::ldir:
+		return "ops.ldir();";
+	case operation_type::cpd:
+		return "ops.cpd();";
+	case operation_type::cpdr:
+		return "ops.cpdr();";
+	case operation_type::cpi:
+		return "ops.cpi();";
+	case operation_type::cpir:
+		return "ops.cpir();";
+	case operation_type::ldd:
+		return "ops.ldd();";
+	case operation_type::lddr:
+		return "ops.lddr();";
+
+	case operation_type::rlca:
+		return "ops.rlca();";
+	case operation_type::rrca:
+		return "ops.rrca();";
+	case operation_type::rla:
+		return "ops.rla();";
+	case operation_type::rra:
+		return "ops.rra();";
+	case operation_type::rld:
+		return "ops.rld();";
+	case operation_type::rrd:
+		return "ops.rrd();";
+	case operation_type::rlc:
+		return "ops.rlc(" + reg_8(dest) + ");";
+	case operation_type::rlc_at:
+		return "ops.rlc_at(" + address(dest, inst) + ");";
+	case operation_type::rrc:
+		return "ops.rrc(" + reg_8(dest) + ");";
+	case operation_type::rrc_at:
+		return "ops.rrc_at(" + address(dest, inst) + ");";
+	case operation_type::rl:
+		return "ops.rl(" + reg_8(dest) + ");";
+	case operation_type::rl_at:
+		return "ops.rl_at(" + address(dest, inst) + ");";
+	case operation_type::rr:
+		return "ops.rr(" + reg_8(dest) + ");";
+	case operation_type::rr_at:
+		return "ops.rr_at(" + address(dest, inst) + ");";
+	case operation_type::sla:
+		return "ops.sla(" + reg_8(dest) + ");";
+	case operation_type::sla_at:
+		return "ops.sla_at(" + address(dest, inst) + ");";
+	case operation_type::sra:
+		return "ops.sra(" + reg_8(dest) + ");";
+	case operation_type::sra_at:
+		return "ops.sra_at(" + address(dest, inst) + ");";
+	case operation_type::srl:
+		return "ops.srl(" + reg_8(dest) + ");";
+	case operation_type::srl_at:
+		return "ops.srl_at(" + address(dest, inst) + ");";
+	case operation_type::sll:
+		return "ops.sll(" + reg_8(dest) + ");";
+	case operation_type::sll_at:
+		return "ops.sll_at(" + address(dest, inst) + ");";
+
+	case operation_type::tst_bit:
+		return "ops.tst_bit(" + byte(dest, inst) + ", " + bit_operand(inst) + ");";
+	case operation_type::tst_bit_at:
+		return "ops.tst_bit_at(" + address(dest, inst) + ", " + bit_operand(inst) + ");";
+	case operation_type::set_bit:
+		return "ops.set_bit(" + reg_8(dest) + ", " + bit_operand(inst) + ");";
+	case operation_type::set_bit_at:
+		return "ops.set_bit_at(" + address(dest, inst) + ", " + bit_operand(inst) + ");";
+	case operation_type::res_bit:
+		return "ops.res_bit(" + reg_8(dest) + ", " + bit_operand(inst) + ");";
+	case operation_type::res_bit_at:
+		return "ops.res_bit_at(" + address(dest, inst) + ", " + bit_operand(inst) + ");";
+
+	case operation_type::daa:
+		return "ops.daa();";
+	case operation_type::cpl:
+		return "ops.cpl();";
+	case operation_type::neg:
+		return "ops.neg();";
+	case operation_type::ccf:
+		return "ops.ccf();";
+	case operation_type::scf:
+		return "ops.scf();";
+
+	default:
+		throw std::runtime_error("op_call: unsupported operation_type " + std::to_string(inst.op_type));
+	}
+}
+
+void print_handler(std::ostream& os, const std::string& name, operation_type op, const std::string& call,
+				   std::uint8_t pc_advance)
+{
+	os << "void " << name << "()\n";
+	os << "{\n";
+
+	if(!keeps_flags_deferred(op))
+		os << "\tregs.sync_flags();\n";
+
+	if(!call.empty())
+		os << "\t" << call << "\n";
+
+	if(need_advance_pc(op) && pc_advance != 0)
+		os << "\tregs.PC += " << std::to_string(pc_advance) << ";\n";
+
+	os << "}\n\n";
+}
+
+void print_instruction_handler(std::ostream& os, prefix pref, const instruction& inst)
+{
+	std::uint8_t opcode = pref == prefix::base ? inst.opcodes[0] : inst.opcodes[1];
+	std::uint8_t size = inst_size(inst) + operand_size(inst.source) + operand_size(inst.destination);
+
+	print_handler(os, handler_name(pref, opcode), inst.op_type, op_call(inst), size);
+}
+
+// DDCB/FDCB instructions encode operation in the 4th byte, mirrors executioner::exec_bit_group
+void print_bit_group_handler(std::ostream& os, prefix pref, std::uint8_t data)
+{
+	const auto addr_mode = pref == prefix::ddcb ? addressing_mode::indexed_ix : addressing_mode::indexed_iy;
+	const std::string addr = indexed(addr_mode);
+	const std::string bit = std::to_string((data & 0b00111000) >> 3);
+
+	static const addressing_mode bit_regs[] = {
+		addressing_mode::register_b, addressing_mode::register_c, addressing_mode::register_d,
+		addressing_mode::register_e, addressing_mode::register_h, addressing_mode::register_l,
+		addressing_mode::none,		 addressing_mode::register_a,
+	};
+
+	std::string reg;
+	if((data & 0b111) != 0b110)
+		reg = ", " + reg_8(bit_regs[data & 0b111]);
+
+	operation_type op;
+	std::string call;
+	switch(data >> 6)
+	{
+	case 0b01:
+		op = operation_type::tst_bit_at;
+		call = "ops.tst_bit_at(" + addr + ", " + bit + ");";
+		break;
+	case 0b11:
+		op = operation_type::set_bit_at;
+		call = "ops.set_bit_at(" + addr + ", " + bit + reg + ");";
+		break;
+	case 0b10:
+		op = operation_type::res_bit_at;
+		call = "ops.res_bit_at(" + addr + ", " + bit + reg + ");";
+		break;
+	default: {
+		static const std::pair<operation_type, const char*> shifts[] = {
+			{operation_type::rlc_at, "rlc_at"}, {operation_type::rrc_at, "rrc_at"},
+			{operation_type::rl_at, "rl_at"},	{operation_type::rr_at, "rr_at"},
+			{operation_type::sla_at, "sla_at"}, {operation_type::sra_at, "sra_at"},
+			{operation_type::sll_at, "sll_at"}, {operation_type::srl_at, "srl_at"},
+		};
+		auto [shift_op, shift_name] = shifts[(data & 0b00111000) >> 3];
+		op = shift_op;
+		call = std::string("ops.") + shift_name + "(" + addr + reg + ");";
+		break;
+	}
+	}
+
+	// prefix + opcode + displacement + data
+	print_handler(os, handler_name(pref, data), op, call, 4);
+}
+
+// dispatch to the table of the next prefix
+void print_prefix_handler(std::ostream& os, prefix pref, std::uint8_t opcode, prefix next, int opcode_offset)
+{
+	os << "void " << handler_name(pref, opcode) << "()\n";
+	os << "{\n";
+	os << "\t(this->*" << prefix_str(next) << "_handler(mem.read<std::uint8_t>(regs.PC + " << opcode_offset
+	   << ")))();\n";
+	os << "}\n\n";
+}
+
+void print_table(std::ostream& os, prefix pref, const std::map<std::uint8_t, std::string>& handlers,
+				 const std::string& unknown)
+{
+	os << "static constexpr std::array<handler, 0x100> " << prefix_str(pref) << "_handlers = {\n";
+
+	for(int i = 0; i <= 0xFF; ++i)
+	{
+		auto it = handlers.find(i);
+		os << "\t&executioner::" << (it != handlers.end() ? it->second : unknown) << ", // " << hex(i) << "\n";
+	}
+
+	os << "};\n\n";
+
+	os << "static handler " << prefix_str(pref) << "_handler(std::uint8_t opcode)\n";
+	os << "{\n";
+	os << "\treturn " << prefix_str(pref) << "_handlers[opcode];\n";
+	os << "}\n\n";
+}
+
+std::optional<prefix> prefix_of(const instruction& inst)
+{
+	switch(inst.opcodes[0])
+	{
+	case 0xCB:
+		return prefix::cb;
+	case 0xDD:
+		return prefix::dd;
+	case 0xFD:
+		return prefix::fd;
+	case 0xED:
+		return prefix::ed;
+	default:
+		return std::nullopt;
+	}
+}
+
+void generate(std::ostream& os)
+{
+	os << "// Generated by z80/impl/gen/exec_generator.cpp, do not edit\n\n";
+
+	std::map<prefix, std::map<std::uint8_t, std::string>> tables;
+
+	// unknown instructions are executed as NOP
+	print_handler(os, "exec_unknown", operation_type::nop, "", 1);
+	print_handler(os, "exec_unknown_prefixed", operation_type::nop, "", 2);
+
+	for(const auto& inst : instructions)
+	{
+		auto pref = prefix_of(inst).value_or(prefix::base);
+		std::uint8_t opcode = pref == prefix::base ? inst.opcodes[0] : inst.opcodes[1];
+
+		if(inst.op_type == operation_type::bit_group)
+		{
+			prefix next = pref == prefix::dd ? prefix::ddcb : prefix::fdcb;
+			print_prefix_handler(os, pref, opcode, next, 3);
+		}
+		else
+		{
+			print_instruction_handler(os, pref, inst);
+		}
+
+		auto& table = tables[pref];
+		if(table.contains(opcode))
+			throw std::runtime_error("generate: duplicate opcode " + hex(inst.opcodes[0]) + " " + hex(opcode));
+		table[opcode] = handler_name(pref, opcode);
+	}
+
+	for(prefix pref : {prefix::cb, prefix::dd, prefix::fd, prefix::ed})
+	{
+		std::uint8_t opcode = 0;
+		switch(pref)
+		{
+		case prefix::cb:
+			opcode = 0xCB;
+			break;
+		case prefix::dd:
+			opcode = 0xDD;
+			break;
+		case prefix::fd:
+			opcode = 0xFD;
+			break;
+		default:
+			opcode = 0xED;
+			break;
+		}
+
+		print_prefix_handler(os, prefix::base, opcode, pref, 1);
+		tables[prefix::base][opcode] = handler_name(prefix::base, opcode);
+	}
+
+	for(prefix pref : {prefix::ddcb, prefix::fdcb})
+	{
+		for(int data = 0; data <= 0xFF; ++data)
+		{
+			print_bit_group_handler(os, pref, data);
+			tables[pref][data] = handler_name(pref, data);
+		}
+	}
+
+	for(auto pref : {prefix::base, prefix::cb, prefix::dd, prefix::fd, prefix::ed, prefix::ddcb, prefix::fdcb})
+		print_table(os, pref, tables[pref], pref == prefix::base ? "exec_unknown" : "exec_unknown_prefixed");
+}
+
+int main(int argc, char* argv[])
+{
+	if(argc != 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <output file>" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::ofstream fs(argv[1]);
+	if(!fs.is_open())
+	{
+		std::cerr << "Failed to open " << argv[1] << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		generate(fs);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << "exec_generator error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
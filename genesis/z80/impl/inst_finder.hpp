@@ -70,12 +70,14 @@ public:
 		if(idx == no_index)
 			return make_nop(op1, op2);
 
+#ifndef NDEBUG
 		// self-check
 		auto inst = instructions[idx];
 		if(op1 != inst.opcodes[0] || (inst.opcodes[1] != 0x0 && inst.opcodes[1] != op2))
 		{
 			throw std::runtime_error("internal error: self-check failed, we popped up a wrong instruction!");
 		}
+#endif
 
 		return instructions[idx];
 	}
@@ -1010,6 +1010,94 @@ const instruction instructions[] = {
 };
 
 
+// returns false if operation controls PC itself
+constexpr bool need_advance_pc(operation_type op)
+{
+	switch(op)
+	{
+	case operation_type::call:
+	case operation_type::call_cc:
+	case operation_type::rst:
+	case operation_type::ret:
+	case operation_type::reti:
+	case operation_type::retn:
+	case operation_type::ret_cc:
+	case operation_type::jp:
+	case operation_type::jp_cc:
+	case operation_type::jr:
+	case operation_type::jr_z:
+	case operation_type::jr_nz:
+	case operation_type::jr_c:
+	case operation_type::jr_nc:
+	case operation_type::ldir:
+	case operation_type::cpdr:
+	case operation_type::cpir:
+	case operation_type::lddr:
+	case operation_type::djnz:
+	case operation_type::inir:
+	case operation_type::indr:
+	case operation_type::otir:
+	case operation_type::otdr:
+		return false;
+	default:
+		return true;
+	}
+}
+
+// returns true if operation neither reads nor modifies F, so deferred flags can be evaluated later
+constexpr bool keeps_flags_deferred(operation_type op)
+{
+	switch(op)
+	{
+	// these sync flags themselves if required
+	case operation_type::add:
+	case operation_type::adc:
+	case operation_type::sub:
+	case operation_type::sbc:
+	case operation_type::and_8:
+	case operation_type::or_8:
+	case operation_type::xor_8:
+	case operation_type::cp:
+	case operation_type::inc_reg:
+	case operation_type::dec_reg:
+	case operation_type::inc_at:
+	case operation_type::dec_at:
+
+	case operation_type::ld_reg:
+	case operation_type::ld_at:
+	case operation_type::ld_16_at:
+	case operation_type::ld_16_reg:
+	case operation_type::ld_16_reg_from:
+	case operation_type::inc_reg_16:
+	case operation_type::dec_reg_16:
+	case operation_type::ex_de_hl:
+	case operation_type::exx:
+	case operation_type::ex_16_at:
+	case operation_type::call:
+	case operation_type::rst:
+	case operation_type::ret:
+	case operation_type::reti:
+	case operation_type::retn:
+	case operation_type::jp:
+	case operation_type::jr:
+	case operation_type::djnz:
+	case operation_type::nop:
+	case operation_type::di:
+	case operation_type::ei:
+	case operation_type::in:
+	case operation_type::out:
+	case operation_type::out_reg:
+	case operation_type::set_bit:
+	case operation_type::res_bit:
+	case operation_type::set_bit_at:
+	case operation_type::res_bit_at:
+		return true;
+	default:
+		return false;
+	}
+}
+
+
 } // namespace genesis::z80
 
 #endif // __INSTRUCTIONS_HPP__
@@ -405,43 +405,28 @@ public:
 	}
 
 	/* 8-Bit Arithmetic Group */
+
+	// Flags of 8-bit arithmetic/logic operations are not evaluated right away,
+	// executioner syncs them before the next instruction which reads/modifies F
 	inline void add(std::int8_t b)
 	{
 		std::uint8_t _a = (std::uint8_t)regs.main_set.A;
 		std::uint8_t _b = (std::uint8_t)b;
 
-		auto& flags = regs.main_set.flags;
-
-		flags.H = check_half_carry<std::uint8_t>(regs.main_set.A, b);
-		flags.PV = cpu_flags::overflow_add<std::int8_t>(regs.main_set.A, b);
-		flags.C = cpu_flags::carry<std::uint8_t>(regs.main_set.A, b);
-
-		flags.N = 0;
-
 		regs.main_set.A = _a + _b;
-
-		set_sz(regs.main_set.A);
-		set_yx(regs.main_set.A);
+		regs.defer_flags(flags_op::add, _a, _b, 0, regs.main_set.A);
 	}
 
 	inline void adc(std::int8_t b)
 	{
+		regs.sync_flags();
+
 		std::uint8_t _a = (std::uint8_t)regs.main_set.A;
 		std::uint8_t _b = (std::uint8_t)b;
 		std::uint8_t _c = regs.main_set.flags.C;
 
-		auto& flags = regs.main_set.flags;
-
-		flags.H = check_half_carry<std::uint8_t>(regs.main_set.A, b, _c);
-		flags.PV = cpu_flags::overflow_add<std::int8_t>(regs.main_set.A, b, _c);
-		flags.C = cpu_flags::carry<std::uint8_t>(regs.main_set.A, b, _c);
-
-		flags.N = 0;
-
 		regs.main_set.A = _a + _b + _c;
-
-		set_sz(regs.main_set.A);
-		set_yx(regs.main_set.A);
+		regs.defer_flags(flags_op::add, _a, _b, _c, regs.main_set.A);
 	}
 
 	inline void sub(std::int8_t b)
@@ -449,38 +434,20 @@ public:
 		std::uint8_t _a = (std::uint8_t)regs.main_set.A;
 		std::uint8_t _b = (std::uint8_t)b;
 
-		auto& flags = regs.main_set.flags;
-
-		flags.H = check_half_borrow<std::uint8_t>(regs.main_set.A, b);
-		flags.PV = cpu_flags::overflow_sub<std::int8_t>(regs.main_set.A, b);
-		flags.C = cpu_flags::borrow<std::uint8_t>(regs.main_set.A, b);
-
-		flags.N = 1;
-
 		regs.main_set.A = _a - _b;
-
-		set_sz(regs.main_set.A);
-		set_yx(regs.main_set.A);
+		regs.defer_flags(flags_op::sub, _a, _b, 0, regs.main_set.A);
 	}
 
 	inline void sbc(std::int8_t b)
 	{
+		regs.sync_flags();
+
 		std::uint8_t _a = (std::uint8_t)regs.main_set.A;
 		std::uint8_t _b = (std::uint8_t)b;
 		std::uint8_t _c = regs.main_set.flags.C;
 
-		auto& flags = regs.main_set.flags;
-
-		flags.H = check_half_borrow<std::uint8_t>(regs.main_set.A, b, _c);
-		flags.PV = cpu_flags::overflow_sub<std::int8_t>(regs.main_set.A, b, _c);
-		flags.C = cpu_flags::borrow<std::uint8_t>(regs.main_set.A, b, _c);
-
-		flags.N = 1;
-
 		regs.main_set.A = _a - _b - _c;
-
-		set_sz(regs.main_set.A);
-		set_yx(regs.main_set.A);
+		regs.defer_flags(flags_op::sub, _a, _b, _c, regs.main_set.A);
 	}
 
 	inline void and_8(std::int8_t b)
@@ -488,17 +455,8 @@ public:
 		std::uint8_t _a = (std::uint8_t)regs.main_set.A;
 		std::uint8_t _b = (std::uint8_t)b;
 
-		auto& flags = regs.main_set.flags;
-
-		flags.N = flags.C = 0;
-		flags.H = 1;
-
 		regs.main_set.A = _a & _b;
-
-		set_parity(regs.main_set.A);
-
-		set_sz(regs.main_set.A);
-		set_yx(regs.main_set.A);
+		regs.defer_flags(flags_op::and_8, _a, _b, 0, regs.main_set.A);
 	}
 
 	inline void or_8(std::int8_t b)
@@ -506,15 +464,8 @@ public:
 		std::uint8_t _a = (std::uint8_t)regs.main_set.A;
 		std::uint8_t _b = (std::uint8_t)b;
 
-		auto& flags = regs.main_set.flags;
-
-		flags.H = flags.N = flags.C = 0;
-
 		regs.main_set.A = _a | _b;
-
-		set_parity(regs.main_set.A);
-		set_sz(regs.main_set.A);
-		set_yx(regs.main_set.A);
+		regs.defer_flags(flags_op::or_8, _a, _b, 0, regs.main_set.A);
 	}
 
 	inline void xor_8(std::int8_t b)
@@ -522,45 +473,24 @@ public:
 		std::uint8_t _a = (std::uint8_t)regs.main_set.A;
 		std::uint8_t _b = (std::uint8_t)b;
 
-		auto& flags = regs.main_set.flags;
-
-		flags.H = flags.N = flags.C = 0;
-
 		regs.main_set.A = _a ^ _b;
-
-		set_parity(regs.main_set.A);
-		set_sz(regs.main_set.A);
-		set_yx(regs.main_set.A);
+		regs.defer_flags(flags_op::or_8, _a, _b, 0, regs.main_set.A);
 	}
 
 	inline void cp(std::int8_t b)
 	{
-		auto& flags = regs.main_set.flags;
-
-		flags.H = check_half_borrow<std::uint8_t>(regs.main_set.A, b);
-		flags.PV = cpu_flags::overflow_sub<std::int8_t>(regs.main_set.A, b);
-		flags.C = cpu_flags::borrow<std::uint8_t>(regs.main_set.A, b);
-		flags.N = 1;
+		std::uint8_t _a = (std::uint8_t)regs.main_set.A;
+		std::uint8_t _b = (std::uint8_t)b;
 
-		std::int8_t diff = (std::uint8_t)regs.main_set.A - (std::uint8_t)b;
-		set_sz(diff);
-		set_yx(b);
+		regs.defer_flags(flags_op::cp, _a, _b, 0, _a - _b);
 	}
 
 	inline void inc_reg(std::int8_t& r)
 	{
-		auto& flags = regs.main_set.flags;
-
 		std::uint8_t _r = r;
 
-		flags.N = 0;
-		flags.PV = _r == 127 ? 1 : 0;
-		flags.H = (_r & 0xf) == 0xf ? 1 : 0;
-
 		r = _r + 1;
-
-		set_sz(r);
-		set_yx(r);
+		regs.defer_flags(flags_op::inc, _r, 1, 0, r);
 	}
 
 	inline void inc_at(z80::memory::address addr)
@@ -572,18 +502,10 @@ public:
 
 	inline void dec_reg(std::int8_t& r)
 	{
-		auto& flags = regs.main_set.flags;
-
 		std::uint8_t _r = r;
 
-		flags.N = 1;
-		flags.PV = r == -128 ? 1 : 0;
-		flags.H = (_r & 0xf) == 0 ? 1 : 0;
-
 		r = _r - 1;
-
-		set_sz(r);
-		set_yx(r);
+		regs.defer_flags(flags_op::dec, _r, 1, 0, r);
 	}
 
 	inline void dec_at(z80::memory::address addr)
@@ -722,6 +644,7 @@ public:
 		auto data = mem.read<std::uint8_t>(regs.main_set.HL);
 		std::uint8_t c = regs.main_set.flags.C;
 		cp(data);
+		regs.sync_flags();
 
 		regs.main_set.flags.PV = regs.main_set.BC != 1 ? 1 : 0;
 		regs.main_set.flags.C = c;
@@ -750,6 +673,7 @@ public:
 		auto data = mem.read<std::int8_t>(regs.main_set.HL);
 		std::uint8_t c = regs.main_set.flags.C;
 		cp(data);
+		regs.sync_flags();
 
 		regs.main_set.flags.PV = regs.main_set.BC != 1 ? 1 : 0;
 		regs.main_set.flags.C = c;
@@ -5,7 +5,9 @@
 #include "memory/addressable.h"
 #include "memory/memory_unit.h"
 
+#include <bit>
 #include <memory>
+#include <span>
 
 namespace genesis::z80
 {
@@ -28,26 +30,64 @@ public:
 	}
 
 	// Use this default constructable objects for backword compatability
-	memory() : memory(std::make_shared<genesis::memory::memory_unit>(0xFFFF, std::endian::little))
+	memory() : memory(std::make_shared<genesis::memory::memory_unit<std::endian::little>>(0xFFFF))
 	{
 	}
 
+	// RAM is accessed directly, bypassing addressable, for addresses in [0 ; end)
+	// buffer is mirrored across the whole range, so its size must be a power of 2
+	// NOTE: RAM must not have side effects on read/write
+	void set_direct_ram(std::span<std::uint8_t> ram, std::uint32_t end)
+	{
+		if(!std::has_single_bit(ram.size()))
+			throw std::invalid_argument("ram");
+
+		if(end > max_address + 1)
+			throw std::invalid_argument("end");
+
+		m_ram = ram.data();
+		m_ram_mask = static_cast<std::uint16_t>(ram.size() - 1);
+		m_ram_end = m_direct_ram_end = end;
+	}
+
+	const std::shared_ptr<genesis::memory::addressable>& get_addressable() const
+	{
+		return addressable;
+	}
+
+	// replaced device must forward accesses to the original one
+	void set_addressable(std::shared_ptr<genesis::memory::addressable> unit)
+	{
+		if(unit == nullptr)
+			throw std::invalid_argument("unit");
+
+		addressable = std::move(unit);
+	}
+
+	// while suspended RAM is accessed through addressable
+	void suspend_direct_ram(bool suspend)
+	{
+		m_ram_end = suspend ? 0 : m_direct_ram_end;
+	}
+
 	template <class T>
 	T read(address addr)
 	{
 		static_assert(sizeof(T) == 1 || sizeof(T) == 2);
 
-		// assume the result is available immediately, should be good enough for now
-		if constexpr(sizeof(T) == 1)
+		if(addr + sizeof(T) <= m_ram_end)
 		{
-			addressable->init_read_byte(addr);
-			return addressable->latched_byte();
+			if constexpr(sizeof(T) == 1)
+				return m_ram[addr & m_ram_mask];
+			else
+				return m_ram[addr & m_ram_mask] | (m_ram[(addr + 1) & m_ram_mask] << 8);
 		}
+
+		// assume the result is available immediately, should be good enough for now
+		if constexpr(sizeof(T) == 1)
+			return addressable->read_byte_now(addr);
 		else
-		{
-			addressable->init_read_word(addr);
-			return addressable->latched_word();
-		}
+			return addressable->read_word_now(addr);
 	}
 
 	template <class T>
@@ -55,6 +95,14 @@ public:
 	{
 		static_assert(sizeof(T) == 1 || sizeof(T) == 2);
 
+		if(addr + sizeof(T) <= m_ram_end)
+		{
+			m_ram[addr & m_ram_mask] = std::uint8_t(data);
+			if constexpr(sizeof(T) == 2)
+				m_ram[(addr + 1) & m_ram_mask] = std::uint8_t(std::uint16_t(data) >> 8);
+			return;
+		}
+
 		if constexpr(sizeof(T) == 1)
 			addressable->init_write(addr, std::uint8_t(data));
 		else
@@ -63,6 +111,11 @@ public:
 
 private:
 	std::shared_ptr<genesis::memory::addressable> addressable;
+
+	std::uint8_t* m_ram = nullptr;
+	std::uint16_t m_ram_mask = 0;
+	std::uint32_t m_ram_end = 0;
+	std::uint32_t m_direct_ram_end = 0;
 };
 
 } // namespace genesis::z80
@@ -0,0 +1,86 @@
+#include "cheats.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace genesis;
+
+
+TEST(CHEATS, GAME_GENIE)
+{
+	ASSERT_EQ((cheat_patch{0x000002, 0x0008, 2}), decode_game_genie("BAAA-AAAC"));
+	ASSERT_EQ((cheat_patch{0x000002, 0x0008, 2}), decode_game_genie("baaaaaac"));
+	ASSERT_EQ((cheat_patch{0x000002, 0x8000, 2}), decode_game_genie("AAAA-ABAC"));
+	ASSERT_EQ((cheat_patch{0x100000, 0x0000, 2}), decode_game_genie("AAAB-AAAA"));
+	ASSERT_EQ((cheat_patch{0x0FFFFE, 0xFFFF, 2}), decode_game_genie("999T-9998"));
+}
+
+TEST(CHEATS, GAME_GENIE_INVALID)
+{
+	// odd address
+	ASSERT_THROW(decode_game_genie("AAAA-AAAB"), std::invalid_argument);
+
+	// address is out of ROM
+	ASSERT_THROW(decode_game_genie("9999-9998"), std::invalid_argument);
+
+	ASSERT_THROW(decode_game_genie("AAAA-AAA"), std::invalid_argument);
+	ASSERT_THROW(decode_game_genie("AAA-AAAAA"), std::invalid_argument);
+	ASSERT_THROW(decode_game_genie("AAAA-AAAI"), std::invalid_argument);
+}
+
+TEST(CHEATS, ACTION_REPLAY)
+{
+	ASSERT_EQ((cheat_patch{0xFFF0A0, 0x0063, 2}), decode_action_replay("FFF0A0:0063"));
+	ASSERT_EQ((cheat_patch{0xFF0001, 0x05, 1}), decode_action_replay("ff0001:05"));
+	ASSERT_EQ((cheat_patch{0x00123A, 0x4E71, 2}), decode_action_replay("00123A:4E71"));
+
+	// neither ROM nor RAM
+	ASSERT_THROW(decode_action_replay("A00000:0000"), std::invalid_argument);
+
+	// word at odd address
+	ASSERT_THROW(decode_action_replay("FF0001:1234"), std::invalid_argument);
+
+	ASSERT_THROW(decode_action_replay("FF000:12"), std::invalid_argument);
+	ASSERT_THROW(decode_action_replay("FF0000:123"), std::invalid_argument);
+	ASSERT_THROW(decode_action_replay("FF0000:12G4"), std::invalid_argument);
+}
+
+TEST(CHEATS, CHEAT_LIST)
+{
+	cheat_list cheats;
+	ASSERT_TRUE(cheats.empty());
+
+	cheats.add("BAAA-AAAC");
+	cheats.add("00123A:4E71");
+	cheats.add("FFF0A0:0063");
+
+	ASSERT_FALSE(cheats.empty());
+	ASSERT_EQ(2, cheats.rom_patches().size());
+	ASSERT_EQ(1, cheats.ram_freezes().size());
+	ASSERT_EQ(0xFFF0A0, cheats.ram_freezes()[0].address);
+
+	ASSERT_THROW(cheats.add("invalid"), std::invalid_argument);
+	ASSERT_EQ(2, cheats.rom_patches().size());
+}
+
+TEST(CHEATS, APPLY_PATCHES)
+{
+	std::vector<std::uint8_t> ram(0x10000);
+
+	std::vector<cheat_patch> patches = {
+		{0xFFF0A0, 0x1234, 2},
+		{0xE00011, 0x56, 1},
+	};
+
+	// RAM is mirrored, so only low 16 bits of address are used
+	apply_patches(patches, ram, 0xFFFF);
+
+	ASSERT_EQ(0x12, ram[0xF0A0]);
+	ASSERT_EQ(0x34, ram[0xF0A1]);
+	ASSERT_EQ(0x56, ram[0x0011]);
+	ASSERT_EQ(0x00, ram[0x0010]);
+
+	std::vector<std::uint8_t> small(0x10);
+	ASSERT_THROW(apply_patches(patches, small, 0xFFFFFF), std::out_of_range);
+}
@@ -0,0 +1,310 @@
+#include "gdb/m68k_stub.h"
+#include "m68k/test_cpu.hpp"
+#include "memory/dummy_memory.h"
+#include "memory/memory_builder.h"
+
+#include <deque>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace genesis;
+
+using test::data_addr;
+using test::program_addr;
+using test::program_start;
+
+
+// Plays debugger packets from a script and captures stub responses
+class scripted_transport : public gdb::transport
+{
+public:
+	void send(std::string_view packet)
+	{
+		std::uint8_t checksum = 0;
+		for(char ch : packet)
+			checksum += static_cast<std::uint8_t>(ch);
+
+		static constexpr char hex_digits[] = "0123456789abcdef";
+		std::string data = "$" + std::string(packet) + "#";
+		data.push_back(hex_digits[checksum >> 4]);
+		data.push_back(hex_digits[checksum & 0xF]);
+
+		m_input.insert(m_input.end(), data.begin(), data.end());
+	}
+
+	std::optional<char> read(bool) override
+	{
+		if(m_input.empty())
+			return std::nullopt;
+
+		char ch = m_input.front();
+		m_input.pop_front();
+		return ch;
+	}
+
+	void write(std::string_view data) override
+	{
+		m_output += data;
+	}
+
+	bool is_closed() const override
+	{
+		return m_input.empty();
+	}
+
+	// payloads of the packets sent by the stub
+	std::vector<std::string> responses() const
+	{
+		std::vector<std::string> res;
+
+		std::size_t pos = 0;
+		while((pos = m_output.find('$', pos)) != std::string::npos)
+		{
+			auto end = m_output.find('#', pos);
+			res.push_back(m_output.substr(pos + 1, end - pos - 1));
+			pos = end;
+		}
+
+		return res;
+	}
+
+private:
+	std::deque<char> m_input;
+	std::string m_output;
+};
+
+static std::vector<std::string> serve(test::test_cpu& cpu, std::initializer_list<std::string_view> packets,
+									  bool expect_kill = false)
+{
+	scripted_transport conn;
+	for(auto packet : packets)
+		conn.send(packet);
+
+	gdb::m68k_stub stub(cpu, cpu.memory(), [&cpu]() { cpu.cycle(); }, conn);
+	EXPECT_EQ(!expect_kill, stub.serve());
+
+	return conn.responses();
+}
+
+TEST(GDB_STUB, QUERIES)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {});
+
+	auto res = serve(cpu, {"qSupported:multiprocess+;swbreak+", "qAttached", "vMustReplyEmpty", "?"});
+
+	ASSERT_EQ(4, res.size());
+	ASSERT_NE(std::string::npos, res[0].find("qXfer:features:read+"));
+	ASSERT_EQ("1", res[1]);
+	ASSERT_EQ("", res[2]);
+	ASSERT_EQ("S05", res[3]);
+}
+
+TEST(GDB_STUB, TARGET_DESCRIPTION)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {});
+
+	auto res = serve(cpu, {"qXfer:features:read:target.xml:0,10", "qXfer:features:read:target.xml:10,fff"});
+
+	ASSERT_EQ(2, res.size());
+	ASSERT_EQ("m<?xml version=\"1", res[0]);
+	ASSERT_EQ('l', res[1][0]);
+	ASSERT_NE(std::string::npos, res[1].find("m68k:68000"));
+}
+
+TEST(GDB_STUB, REGISTERS)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {});
+	cpu.registers().D(1).LW = 0x12345678;
+
+	auto res = serve(cpu, {"g", "P2=deadbeef", "p2", "P9=00001000", "p11"});
+
+	ASSERT_EQ(5, res.size());
+
+	// d0-d7, a0-a7, sr, pc
+	ASSERT_EQ(18 * 8, res[0].size());
+	ASSERT_EQ("12345678", res[0].substr(8, 8));
+
+	ASSERT_EQ("OK", res[1]);
+	ASSERT_EQ("deadbeef", res[2]);
+	ASSERT_EQ("OK", res[3]);
+	ASSERT_EQ(0xDEADBEEF, cpu.registers().D(2).LW);
+	ASSERT_EQ(0x1000, cpu.registers().A(1).LW);
+
+	// pc
+	ASSERT_EQ("00000400", res[4]);
+}
+
+TEST(GDB_STUB, MEMORY)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {});
+	cpu.memory().write<std::uint16_t>(data_addr, 0xABCD);
+
+	auto res = serve(cpu, {"m8000,2", "M8002,3:010203", "m8002,3", "M8000,1:zz"});
+
+	ASSERT_EQ(4, res.size());
+	ASSERT_EQ("abcd", res[0]);
+	ASSERT_EQ("OK", res[1]);
+	ASSERT_EQ("010203", res[2]);
+	ASSERT_EQ("E01", res[3]);
+	ASSERT_EQ(0x0102, cpu.memory().read<std::uint16_t>(data_addr + 2));
+}
+
+TEST(GDB_STUB, UNMAPPED_PC)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {});
+
+	scripted_transport conn;
+	for(auto packet : {"P11=00002000", "p11", "c2000", "p11"})
+		conn.send(packet);
+
+	// stub sees only the first 4KB of memory
+	memory::memory_unit<std::endian::big> memory(0xFFF);
+	gdb::m68k_stub stub(cpu, memory, [&cpu]() { cpu.cycle(); }, conn);
+	ASSERT_TRUE(stub.serve());
+
+	auto res = conn.responses();
+	ASSERT_EQ(4, res.size());
+	ASSERT_EQ("E02", res[0]);
+	ASSERT_EQ("00000400", res[1]);
+	ASSERT_EQ("E02", res[2]);
+	ASSERT_EQ("00000400", res[3]);
+}
+
+TEST(GDB_STUB, ASYNCHRONOUS_MEMORY)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {});
+
+	scripted_transport conn;
+	for(auto packet : {"m0,2", "m1000,2", "mffe,4"})
+		conn.send(packet);
+
+	// reading device ports would change their state
+	memory::memory_builder builder;
+	builder.add(std::make_shared<memory::memory_unit<std::endian::big>>(0xFFF), 0x0);
+	builder.add(std::make_shared<memory::dummy_memory>(0xFFF), 0x1000);
+	auto memory = builder.build();
+
+	gdb::m68k_stub stub(cpu, *memory, [&cpu]() { cpu.cycle(); }, conn);
+	ASSERT_TRUE(stub.serve());
+
+	auto res = conn.responses();
+	ASSERT_EQ(3, res.size());
+	ASSERT_EQ("0000", res[0]);
+	ASSERT_EQ("E02", res[1]);
+	ASSERT_EQ("E02", res[2]);
+}
+
+TEST(GDB_STUB, BREAKPOINT)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {
+						  test::nop_opcode, test::nop_opcode, test::nop_opcode, test::nop_opcode,
+						  test::nop_opcode, // $508
+						  0x60F4,			// BRA.S $500
+					  });
+
+	auto res = serve(cpu, {"Z0,508,2", "c", "p11", "c", "p11"});
+
+	ASSERT_EQ(5, res.size());
+	ASSERT_EQ("OK", res[0]);
+	ASSERT_EQ("S05", res[1]);
+	ASSERT_EQ("00000508", res[2]);
+
+	// program loops and hits the breakpoint again
+	ASSERT_EQ("S05", res[3]);
+	ASSERT_EQ("00000508", res[4]);
+}
+
+TEST(GDB_STUB, STEP)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {
+						  0x7005,		  // MOVEQ #5, D0
+						  0x33C0, 0x0000, // MOVE.W D0, ($8000).L
+						  data_addr,
+					  });
+
+	auto res = serve(cpu, {"P11=00000500", "s", "p0", "p11", "s", "p11", "m8000,2"});
+
+	ASSERT_EQ(7, res.size());
+	ASSERT_EQ("S05", res[1]);
+	ASSERT_EQ("00000005", res[2]);
+	ASSERT_EQ("00000502", res[3]);
+	ASSERT_EQ("S05", res[4]);
+	ASSERT_EQ("00000508", res[5]);
+	ASSERT_EQ("0005", res[6]);
+}
+
+TEST(GDB_STUB, STEP_FROM_BREAKPOINT)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {});
+
+	auto res = serve(cpu, {"Z0,404,2", "c", "s", "p11"});
+
+	ASSERT_EQ(4, res.size());
+	ASSERT_EQ("S05", res[1]);
+	ASSERT_EQ("S05", res[2]);
+	ASSERT_EQ("00000406", res[3]);
+}
+
+TEST(GDB_STUB, STEP_IN_IDLE_LOOP)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {
+						  0x4A79, 0x0000, data_addr, // TST.W ($8000).L
+						  0x67F8,					 // BEQ.S $500
+					  });
+	cpu.enable_idle_loop_skipping([](std::uint32_t address) { return address >= data_addr; });
+
+	cpu.cycle_until([&]() { return cpu.is_skipping_idle_loop(); }, 1000);
+
+	auto res = serve(cpu, {"p11", "s", "p11", "s", "p11"});
+
+	ASSERT_EQ(5, res.size());
+	ASSERT_EQ("00000500", res[0]);
+	ASSERT_EQ("00000506", res[2]);
+	ASSERT_EQ("00000500", res[4]);
+
+	// skipping is resumed once the debugger detaches
+	cpu.cycle_until([&]() { return cpu.is_skipping_idle_loop(); }, 1000);
+}
+
+TEST(GDB_STUB, WATCHPOINT)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {
+						  0x33C0, 0x0000, data_addr, // MOVE.W D0, ($8000).L
+						  0x4A79, 0x0000, data_addr, // TST.W ($8000).L
+					  });
+
+	auto res = serve(cpu, {"Z2,8000,2", "Z3,8000,2", "c", "p11", "c", "z2,8000,2", "z3,8000,2"});
+
+	ASSERT_EQ(7, res.size());
+	ASSERT_EQ("T05watch:00008000;", res[2]);
+
+	// stub stops at the instruction boundary after the access
+	ASSERT_EQ("00000506", res[3]);
+	ASSERT_EQ("T05rwatch:00008000;", res[4]);
+}
+
+TEST(GDB_STUB, DETACH_AND_KILL)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {});
+
+	auto res = serve(cpu, {"Z0,508,2", "D", "g"});
+	ASSERT_EQ(2, res.size());
+	ASSERT_EQ("OK", res[1]);
+
+	// breakpoints are removed on detach
+	cpu.cycle_until([&]() { return cpu.registers().PC > 0x510; }, 1000);
+
+	serve(cpu, {"k"}, true);
+}
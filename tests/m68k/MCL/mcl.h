@@ -12,7 +12,7 @@ namespace genesis::test
 namespace __impl
 {
 
-static inline void nop_some_tests(genesis::memory::memory_unit& mem)
+static inline void nop_some_tests(genesis::memory::memory_unit<std::endian::big>& mem)
 {
 	auto nop_test = [&](std::uint32_t jump_addr) {
 		// jump takes 6 bytes - 2 for opcode, 4 for ptr
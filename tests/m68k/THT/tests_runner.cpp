@@ -83,7 +83,7 @@ void set_preconditions(test::test_cpu& cpu, const cpu_state& state)
 
 	regs.USP.LW = state.USP;
 	regs.SSP.LW = state.SSP;
-	regs.SR = state.SR;
+	regs.set_sr(state.SR);
 	regs.PC = state.PC;
 
 	// setup ram
@@ -126,7 +126,7 @@ bool check_postconditions(test::test_cpu& cpu, const cpu_state& state)
 
 	check_eq(state.USP, regs.USP.LW);
 	check_eq(state.SSP, regs.SSP.LW);
-	check_eq(state.SR, regs.SR);
+	check_eq(state.SR, regs.sr());
 	check_eq(state.PC, regs.PC);
 
 	// check ram
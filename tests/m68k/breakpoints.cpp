@@ -0,0 +1,72 @@
+#include "test_cpu.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace genesis;
+using namespace genesis::m68k;
+
+using test::data_addr;
+using test::program_addr;
+using test::program_start;
+
+
+TEST(M68K_BREAKPOINTS, STOP_BEFORE_EXECUTION)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {});
+
+	const std::uint32_t break_addr = program_start + 8;
+
+	std::vector<break_event> events;
+	cpu.on_break([&](const break_event& ev) { events.push_back(ev); });
+	cpu.add_breakpoint(break_type::execution, break_addr);
+
+	cpu.cycle_until([&]() { return !events.empty(); }, 100);
+	ASSERT_EQ(1, events.size());
+	ASSERT_EQ(break_type::execution, events[0].type);
+	ASSERT_EQ(break_addr, events[0].address);
+
+	// instruction at breakpoint is not started yet
+	ASSERT_EQ(break_addr, cpu.registers().PC);
+
+	// resume
+	cpu.cycle_until([&]() { return cpu.registers().PC > break_addr; }, 10);
+	ASSERT_EQ(1, events.size());
+
+	// cpu runs freely once breakpoint is removed
+	cpu.remove_breakpoint(break_type::execution, break_addr);
+	cpu.registers().PC = program_start;
+	cpu.cycle_until([&]() { return cpu.registers().PC > break_addr + 8; }, 100);
+	ASSERT_EQ(1, events.size());
+}
+
+TEST(M68K_BREAKPOINTS, WATCHPOINTS)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, program_start, {
+						  0x33C0, 0x0000, data_addr,	 // MOVE.W D0, ($8000).L
+						  0x4A39, 0x0000, data_addr + 1, // TST.B ($8001).L
+					  });
+
+	std::vector<break_event> events;
+	cpu.on_break([&](const break_event& ev) { events.push_back(ev); });
+
+	// byte access at odd address hits the word watchpoint
+	cpu.add_breakpoint(break_type::write, data_addr);
+	cpu.add_breakpoint(break_type::read, data_addr);
+
+	cpu.cycle_until([&]() { return events.size() == 2; }, 1000);
+	ASSERT_EQ(break_type::write, events[0].type);
+	ASSERT_EQ(data_addr, events[0].address);
+	ASSERT_EQ(break_type::read, events[1].type);
+	ASSERT_EQ(data_addr + 1, events[1].address);
+
+	// no events once watchpoints are cleared
+	cpu.clear_breakpoints();
+	events.clear();
+
+	cpu.registers().PC = program_start;
+	cpu.cycle_until([&]() { return cpu.registers().PC > program_addr + 16; }, 1000);
+	ASSERT_TRUE(events.empty());
+}
@@ -1,4 +1,5 @@
 #include "helpers/random.h"
+#include "memory/dummy_memory.h"
 #include "test_cpu.hpp"
 #include "test_program.h"
 
@@ -8,7 +9,7 @@
 using namespace genesis;
 
 
-void prepare_mem(memory::memory_unit& mem, std::uint32_t base_addr, const auto& array)
+void prepare_mem(memory::memory_unit<std::endian::big>& mem, std::uint32_t base_addr, const auto& array)
 {
 	for(auto val : array)
 	{
@@ -138,6 +139,20 @@ TEST(M68K_BUS_MANAGER, READ_WORD)
 	test_read(gen_test_words());
 }
 
+TEST(M68K_BUS_MANAGER, READ_ASYNCHRONOUS_DEVICE)
+{
+	// synchronous devices are read in one call, others must go through the init/latched protocol
+	test::test_cpu cpu;
+	auto& busm = cpu.bus_manager();
+	busm.set_external_memory(std::make_shared<memory::constant_memory_unit<0x12, 0x3456>>(0xFFFFFF));
+
+	ASSERT_EQ(4, read_byte(busm, 0x101));
+	ASSERT_EQ(0x12, busm.latched_byte());
+
+	ASSERT_EQ(4, read_word(busm, 0x100));
+	ASSERT_EQ(0x3456, busm.latched_word());
+}
+
 TEST(M68K_BUS_MANAGER, WRITE_BYTE)
 {
 	test_write(gen_test_bytes());
@@ -271,7 +286,7 @@ bus_state int_ack_and_track(test::test_cpu& cpu, std::uint8_t priority = 1)
 	auto& bus = cpu.bus();
 	auto& busm = cpu.bus_manager();
 
-	cpu.registers().flags.IPM = 0; // enable all interrupts
+	cpu.registers().set_ipm(0); // enable all interrupts
 
 	std::uint32_t cycle = 0;
 	bus_state bs;
@@ -422,7 +437,7 @@ const std::uint32_t int_ack_cycles = 4;
 template <class Callback = std::nullptr_t>
 std::uint32_t interrupt_ack(test::test_cpu& cpu, std::uint8_t int_priority = 1, Callback callback = nullptr)
 {
-	cpu.registers().flags.IPM = 0;
+	cpu.registers().set_ipm(0);
 	auto& busm = cpu.bus_manager();
 	busm.init_interrupt_ack(int_priority, callback);
 	return wait_idle(busm);
@@ -0,0 +1,36 @@
+#include "m68k/cpu_registers.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace genesis::m68k;
+
+
+TEST(M68K_CPU_REGISTERS, DEFERRED_CCR_EVALUATED_ON_READ)
+{
+	cpu_registers regs;
+	regs.set_sr(0x2700);
+
+	// 0x7F + 0x01 = 0x80: N and V are set
+	regs.defer_ccr(ccr_op::add, size_type::BYTE, 0x7F, 0x01, 0x80);
+	ASSERT_TRUE(regs.ccr_deferred());
+
+	ASSERT_EQ(0x270A, regs.sr());
+	ASSERT_FALSE(regs.ccr_deferred());
+}
+
+TEST(M68K_CPU_REGISTERS, SR_WRITE_DISCARDS_DEFERRED_CCR)
+{
+	cpu_registers regs;
+	regs.set_sr(0x2700);
+
+	regs.defer_ccr(ccr_op::sub, size_type::WORD, 0x1, 0x1, 0x0);
+
+	// new CCR is the same as the CCR at the moment of deferring, still deferred flags must be discarded
+	regs.set_sr(0x2700);
+	ASSERT_FALSE(regs.ccr_deferred());
+	ASSERT_EQ(0x2700, regs.sr());
+
+	regs.defer_ccr(ccr_op::sub, size_type::WORD, 0x1, 0x1, 0x0);
+	regs.set_sr(0x2010);
+	ASSERT_EQ(0x2010, regs.sr());
+}
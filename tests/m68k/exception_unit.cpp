@@ -14,7 +14,7 @@
 using namespace genesis::m68k;
 using namespace genesis::test;
 
-void clean_vector_table(genesis::memory::memory_unit& mem)
+void clean_vector_table(genesis::memory::memory_unit<std::endian::big>& mem)
 {
 	for(int addr = 0; addr <= 1024; ++addr)
 		mem.write(addr, std::uint8_t(0));
@@ -25,7 +25,7 @@ void rise_interrupt(test_cpu& cpu, std::uint8_t priority = 1, std::uint8_t IPM =
 	auto& regs = cpu.registers();
 
 	regs.SSP.LW = 2048;
-	regs.flags.IPM = IPM;
+	regs.set_ipm(IPM);
 
 	cpu.set_interrupt(priority);
 }
@@ -47,11 +47,10 @@ void rise_exception(test_cpu& cpu, exception_type ex)
 		exman.rise_trace();
 		break;
 
-	case exception_type::interrupt: {
+	case exception_type::interrupt:
+		// interrupt is raised as soon as IPL changes
 		rise_interrupt(cpu);
-		exman.rise_interrupt(cpu.bus().interrupt_priority());
 		break;
-	}
 
 	default:
 		exman.rise(ex);
@@ -134,9 +133,9 @@ TEST(M68K_EXCEPTION_UNIT, INTERRUPT_VALIDATE_STACK)
 	const std::uint32_t initial_sp = 2048;
 	regs.SSP.LW = initial_sp;
 
-	regs.SR = random::next<std::uint16_t>();
-	regs.flags.IPM = 0;
-	const std::uint16_t initial_sr = regs.SR;
+	regs.set_sr(random::next<std::uint16_t>());
+	regs.set_ipm(0);
+	const std::uint16_t initial_sr = regs.sr();
 
 	const std::uint32_t initial_pc = random::next<std::uint32_t>();
 	regs.PC = initial_pc;
@@ -307,6 +306,37 @@ TEST(M68K_EXCEPTION_UNIT, INTERRUPT_MASKED)
 	}
 }
 
+TEST(M68K_EXCEPTION_UNIT, INTERRUPT_RAISED_ON_IPM_CHANGE)
+{
+	test_cpu cpu;
+	auto& exman = cpu.exception_manager();
+
+	setup_interrupt(cpu, 3, 5);
+	ASSERT_FALSE(exman.is_raised(exception_type::interrupt));
+
+	// pending interrupt is unmasked without executing a single cycle
+	cpu.registers().set_sr(0x2200);
+	ASSERT_TRUE(exman.is_raised(exception_type::interrupt));
+
+	cpu.cycle_till_idle();
+	ASSERT_FALSE(exman.is_raised(exception_type::interrupt));
+	ASSERT_EQ(3, cpu.registers().flags.IPM);
+}
+
+TEST(M68K_EXCEPTION_UNIT, NMI_RAISED_AFTER_ACKNOWLEDGE)
+{
+	test_cpu cpu;
+	auto& exman = cpu.exception_manager();
+
+	setup_interrupt(cpu, 7, 7);
+	cpu.cycle_till_idle();
+
+	// interrupt acknowledge clears IPL, so the next level 7 request is a new edge
+	ASSERT_EQ(0, cpu.bus().interrupt_priority());
+	cpu.set_interrupt(7);
+	ASSERT_TRUE(exman.is_raised(exception_type::interrupt));
+}
+
 /* Interrupt routine:
  * NOP
  * NOP
@@ -440,7 +470,7 @@ TEST(M68K_EXCEPTION_UNIT, INTERRUPT_DURING_PROGRAM_EXECUTION)
 			// overwrite
 			mem.write(vec_addr, routine_address.at(vec_addr));
 			regs.SSP.LW = test_ssp;
-			regs.flags.IPM = 0;
+			regs.set_ipm(0);
 
 			auto priority = setup_int_device(cpu, vec_addr);
 			cpu.set_interrupt(priority);
@@ -460,7 +490,7 @@ TEST(M68K_EXCEPTION_UNIT, INTERRUPT_DURING_PROGRAM_EXECUTION)
 				// restore state
 				mem.write(vec_addr, old_vec_addr);
 				regs.SSP.LW = old_ssp;
-				regs.flags.IPM = old_ipm;
+				regs.set_ipm(old_ipm);
 
 				interrupt_frequency = get_interrupt_frequency();
 				state = test_state::wait;
@@ -549,9 +579,9 @@ TEST(M68K_EXCEPTION_UNIT, BUS_ADDRESS_ERROR_VALIDATE_STACK)
 	const std::uint32_t initial_sp = 2048;
 	regs.SSP.LW = initial_sp;
 
-	regs.SR = random::next<std::uint16_t>();
-	regs.flags.IPM = 0;
-	const std::uint16_t initial_sr = regs.SR;
+	regs.set_sr(random::next<std::uint16_t>());
+	regs.set_ipm(0);
+	const std::uint16_t initial_sr = regs.sr();
 
 	const std::uint32_t initial_pc = random_pc(cpu);
 	regs.PC = initial_pc;
@@ -0,0 +1,143 @@
+#include "test_cpu.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace genesis;
+using namespace genesis::m68k;
+
+
+constexpr std::uint32_t loop_start = test::program_addr;
+constexpr std::uint32_t flag_addr = test::data_addr;
+constexpr std::uint32_t int_handler = 0x600;
+
+// everything above flag_addr is side-effect free
+void enable_skipping(test::test_cpu& cpu)
+{
+	cpu.enable_idle_loop_skipping([](std::uint32_t address) { return address >= flag_addr; });
+}
+
+void cycle(test::test_cpu& cpu, int cycles)
+{
+	for(int i = 0; i < cycles; ++i)
+		cpu.cycle();
+}
+
+TEST(M68K_IDLE_LOOP, OFF_BY_DEFAULT)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, test::program_start, {0x60FE}); // BRA.S *
+
+	cycle(cpu, 1000);
+	ASSERT_FALSE(cpu.is_skipping_idle_loop());
+}
+
+TEST(M68K_IDLE_LOOP, WAKE_ON_MEMORY_CHANGE)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, test::program_start, {
+					   0x4A79, 0x0000, flag_addr, // TST.W ($8000).L
+					   0x67F8,					  // BEQ.S loop
+				   });
+	cpu.memory().write(flag_addr, std::uint16_t(0));
+	enable_skipping(cpu);
+
+	cycle(cpu, 1000);
+	ASSERT_TRUE(cpu.is_skipping_idle_loop());
+	ASSERT_EQ(loop_start, cpu.registers().PC);
+
+	cpu.memory().write(flag_addr, std::uint16_t(1));
+
+	// must wake up within a loop iteration (TST.W + BEQ.S take 26 cycles)
+	cpu.cycle_until([&]() { return !cpu.is_skipping_idle_loop(); }, 50);
+
+	// leave the loop
+	cpu.cycle_until([&]() { return cpu.registers().PC > loop_start + 8; }, 100);
+}
+
+TEST(M68K_IDLE_LOOP, WAKE_ON_INTERRUPT)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, test::program_start, {0x60FE}); // BRA.S *
+
+	const std::uint8_t priority = 3;
+	const std::uint32_t vector_addr = (24 + priority) * 4; // autovector
+	cpu.memory().write(vector_addr, int_handler);
+	cpu.interrupt_dev().set_autovectored();
+	enable_skipping(cpu);
+
+	cycle(cpu, 1000);
+	ASSERT_TRUE(cpu.is_skipping_idle_loop());
+
+	cpu.set_interrupt(priority);
+	cpu.cycle_until([&]() { return cpu.registers().PC >= int_handler; }, 100);
+	ASSERT_FALSE(cpu.is_skipping_idle_loop());
+}
+
+TEST(M68K_IDLE_LOOP, BUSY_LOOPS_ARE_NOT_SKIPPED)
+{
+	// ADDQ.W #1, D0; BRA.S loop
+	test::test_cpu cpu;
+	test::load_program(cpu, test::program_start, {0x5240, 0x60FC});
+	enable_skipping(cpu);
+
+	cycle(cpu, 1000);
+	ASSERT_FALSE(cpu.is_skipping_idle_loop());
+	ASSERT_GT(cpu.registers().D0.W, 20);
+}
+
+TEST(M68K_IDLE_LOOP, WRITING_LOOPS_ARE_NOT_SKIPPED)
+{
+	// MOVE.W D0, ($8000).L; BRA.S loop
+	test::test_cpu cpu;
+	test::load_program(cpu, test::program_start, {0x33C0, 0x0000, flag_addr, 0x60F8});
+	enable_skipping(cpu);
+
+	cycle(cpu, 1000);
+	ASSERT_FALSE(cpu.is_skipping_idle_loop());
+}
+
+TEST(M68K_IDLE_LOOP, LOOPS_WITH_SIDE_EFFECTS_ARE_NOT_SKIPPED)
+{
+	// TST.W ($4000).L; BEQ.S loop
+	test::test_cpu cpu;
+	test::load_program(cpu, test::program_start, {0x4A79, 0x0000, 0x4000, 0x67F8});
+	cpu.memory().write(0x4000, std::uint16_t(0));
+	enable_skipping(cpu);
+
+	cycle(cpu, 1000);
+	ASSERT_FALSE(cpu.is_skipping_idle_loop());
+}
+
+TEST(M68K_IDLE_LOOP, BREAKPOINTS_SUSPEND_SKIPPING)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, test::program_start, {
+					   0x4A79, 0x0000, flag_addr, // TST.W ($8000).L
+					   0x67F8,					  // BEQ.S loop
+				   });
+	cpu.memory().write(flag_addr, std::uint16_t(0));
+	enable_skipping(cpu);
+
+	cycle(cpu, 1000);
+	ASSERT_TRUE(cpu.is_skipping_idle_loop());
+
+	std::vector<break_event> events;
+	cpu.on_break([&](const break_event& ev) { events.push_back(ev); });
+
+	const std::uint32_t break_addr = loop_start + 6;
+	cpu.add_breakpoint(break_type::execution, break_addr);
+
+	cpu.cycle_until([&]() { return !events.empty(); }, 100);
+	ASSERT_FALSE(cpu.is_skipping_idle_loop());
+	ASSERT_EQ(break_addr, events[0].address);
+
+	// the loop is executed while the breakpoint is set
+	cycle(cpu, 1000);
+	ASSERT_FALSE(cpu.is_skipping_idle_loop());
+	ASSERT_GT(events.size(), 10);
+
+	cpu.remove_breakpoint(break_type::execution, break_addr);
+	cycle(cpu, 1000);
+	ASSERT_TRUE(cpu.is_skipping_idle_loop());
+}
@@ -0,0 +1,96 @@
+#include "test_cpu.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace genesis;
+using namespace genesis::m68k;
+
+
+TEST(M68K_PROFILER, OFF_BY_DEFAULT)
+{
+	test::test_cpu cpu;
+	ASSERT_EQ(nullptr, cpu.profiler());
+}
+
+TEST(M68K_PROFILER, FLAT_HISTOGRAM)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, 0, {});
+
+	auto& prof = cpu.enable_profiler(profiler::histogram_type::flat);
+
+	const int num_nops = 100;
+	for(int i = 0; i < num_nops * 4; ++i) // NOP takes 4 cycles
+		cpu.cycle();
+
+	ASSERT_EQ(num_nops * 4, prof.total_cycles());
+	ASSERT_EQ(0, prof.exception_cycles());
+
+	auto insts = prof.instructions();
+	ASSERT_EQ(1, insts.size());
+	ASSERT_EQ(inst_type::NOP, insts[0].inst);
+	ASSERT_EQ(num_nops, insts[0].executions);
+	ASSERT_EQ(num_nops * 4, insts[0].cycles);
+
+	auto pcs = prof.hot_pcs(1000);
+	ASSERT_EQ(num_nops, pcs.size());
+	for(int i = 0; i < num_nops; ++i)
+	{
+		// entries with the same cycles are ordered by PC
+		ASSERT_EQ(i * 2, pcs[i].pc);
+		ASSERT_EQ(1, pcs[i].executions);
+		ASSERT_EQ(4, pcs[i].cycles);
+	}
+
+	ASSERT_EQ(10, prof.hot_pcs(10).size());
+}
+
+TEST(M68K_PROFILER, SAMPLED_HISTOGRAM)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, 0, {});
+
+	auto& prof = cpu.enable_profiler(profiler::histogram_type::sampled, 8);
+
+	const int num_nops = 100;
+	for(int i = 0; i < num_nops * 4; ++i)
+		cpu.cycle();
+
+	ASSERT_EQ(num_nops, prof.instructions().at(0).executions);
+
+	// every other NOP is sampled
+	auto pcs = prof.hot_pcs(1000);
+	ASSERT_EQ(num_nops / 2, pcs.size());
+	for(const auto& st : pcs)
+		ASSERT_EQ(8, st.cycles);
+}
+
+TEST(M68K_PROFILER, REPORTS)
+{
+	test::test_cpu cpu;
+	test::load_program(cpu, 0, {});
+
+	auto& prof = cpu.enable_profiler(profiler::histogram_type::flat);
+	for(int i = 0; i < 8; ++i)
+		cpu.cycle();
+
+	std::stringstream report;
+	prof.write_report(report);
+	ASSERT_NE(report.str().find("NOP"), std::string::npos);
+
+	std::stringstream inst_csv;
+	prof.write_instructions_csv(inst_csv);
+	ASSERT_EQ("inst,executions,cycles\nNOP,2,8\n", inst_csv.str());
+
+	std::stringstream pcs_csv;
+	prof.write_pcs_csv(pcs_csv);
+	ASSERT_EQ("pc,executions,cycles\n0x000000,1,4\n0x000002,1,4\n", pcs_csv.str());
+
+	prof.reset();
+	ASSERT_EQ(0, prof.total_cycles());
+	ASSERT_TRUE(prof.hot_pcs(10).empty());
+
+	cpu.disable_profiler();
+	ASSERT_EQ(nullptr, cpu.profiler());
+}
@@ -6,6 +6,7 @@
 #include "memory/memory_unit.h"
 
 #include <fstream>
+#include <initializer_list>
 
 namespace genesis::test
 {
@@ -20,7 +21,7 @@ const std::uint16_t nop_opcode = 0b0100111001110001;
 class test_cpu : public genesis::m68k::cpu
 {
 private:
-	test_cpu(std::shared_ptr<memory::memory_unit> mem_unit, std::shared_ptr<int_dev> int_dev)
+	test_cpu(std::shared_ptr<memory::memory_unit<std::endian::big>> mem_unit, std::shared_ptr<int_dev> int_dev)
 		: cpu(mem_unit, int_dev), mem_unit(mem_unit), _int_dev(int_dev)
 	{
 		if(exman.is_raised(m68k::exception_type::reset))
@@ -29,11 +30,11 @@ private:
 
 public:
 	test_cpu()
-		: test_cpu(std::make_shared<memory::memory_unit>(0x1000000, std::endian::big), std::make_shared<int_dev>())
+		: test_cpu(std::make_shared<memory::memory_unit<std::endian::big>>(0x1000000), std::make_shared<int_dev>())
 	{
 	}
 
-	memory::memory_unit& memory()
+	memory::memory_unit<std::endian::big>& memory()
 	{
 		return *mem_unit;
 	}
@@ -104,10 +105,38 @@ public:
 	}
 
 private:
-	std::shared_ptr<memory::memory_unit> mem_unit;
+	std::shared_ptr<memory::memory_unit<std::endian::big>> mem_unit;
 	std::shared_ptr<int_dev> _int_dev;
 };
 
+constexpr std::uint32_t program_start = 0x400;
+constexpr std::uint32_t program_addr = 0x500;
+constexpr std::uint32_t data_addr = 0x8000;
+
+// fills memory from start to 0x1000 with NOPs and places the program at program_addr,
+// so execution starts at start and reaches the program through NOPs
+inline void load_program(test_cpu& cpu, std::uint32_t start, std::initializer_list<std::uint16_t> program)
+{
+	auto& mem = cpu.memory();
+	for(std::uint32_t i = start; i < 0x1000; i += 2)
+		mem.write(i, nop_opcode);
+
+	std::uint32_t addr = program_addr;
+	for(auto word : program)
+	{
+		mem.write(addr, word);
+		addr += 2;
+	}
+
+	auto& regs = cpu.registers();
+	regs.flags.TR = 0;
+	regs.flags.S = 1;
+	regs.set_ipm(0);
+	regs.SSP.LW = 0x2000;
+	regs.PC = start;
+	regs.IR = regs.IRC = regs.IRD = nop_opcode;
+}
+
 } // namespace genesis::test
 
 
@@ -0,0 +1,147 @@
+#include "memory/bus_trace.h"
+
+#include "helper.h"
+#include "memory/memory_unit.h"
+#include "memory/tracing_memory.h"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace genesis;
+
+
+namespace
+{
+
+std::filesystem::path trace_path(std::string_view name)
+{
+	return std::filesystem::temp_directory_path() / name;
+}
+
+std::vector<memory::trace_record> read_trace(const std::filesystem::path& path)
+{
+	std::vector<memory::trace_record> records;
+
+	memory::bus_trace_reader reader(path);
+	memory::trace_record rec;
+	while(reader.next(rec))
+		records.push_back(rec);
+
+	return records;
+}
+
+} // namespace
+
+
+TEST(MEMORY, BUS_TRACE_RECORD_ACCESSES)
+{
+	const auto path = trace_path("genesis_bus_trace_record.bin");
+	const std::uint8_t DEVICE_ID = 5;
+
+	std::uint64_t cycles = 0;
+	{
+		// small chunk to extend the file several times
+		memory::bus_trace_recorder recorder({.trace_file = path, .chunk_records = 3}, cycles);
+		memory::tracing_memory mem(std::make_shared<memory::memory_unit<>>(0xFF), recorder, DEVICE_ID);
+
+		cycles = 10;
+		mem.init_write(0x10, std::uint16_t(0xABCD));
+
+		cycles = 20;
+		mem.init_read_word(0x10);
+		cycles = 21;
+		ASSERT_EQ(0xABCD, mem.latched_word());
+		ASSERT_EQ(0xABCD, mem.latched_word()); // recorded once
+
+		cycles = 30;
+		mem.init_write(0x20, std::uint8_t(0x12));
+
+		cycles = 40;
+		ASSERT_EQ(0x12, mem.read_byte_now(0x20));
+
+		ASSERT_EQ(4, recorder.records());
+	}
+
+	auto records = read_trace(path);
+	ASSERT_EQ(4, records.size());
+
+	using memory::trace_access;
+	const std::vector<memory::trace_record> expected = {
+		{10, 0x10, 0xABCD, DEVICE_ID, trace_access::write_word},
+		{20, 0x10, 0xABCD, DEVICE_ID, trace_access::read_word},
+		{30, 0x20, 0x12, DEVICE_ID, trace_access::write_byte},
+		{40, 0x20, 0x12, DEVICE_ID, trace_access::read_byte},
+	};
+
+	for(std::size_t i = 0; i < expected.size(); ++i)
+	{
+		ASSERT_EQ(expected[i].cycle, records[i].cycle);
+		ASSERT_EQ(expected[i].address, records[i].address);
+		ASSERT_EQ(expected[i].data, records[i].data);
+		ASSERT_EQ(expected[i].device_id, records[i].device_id);
+		ASSERT_EQ(expected[i].access, records[i].access);
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST(MEMORY, BUS_TRACE_FILTER)
+{
+	const auto path = trace_path("genesis_bus_trace_filter.bin");
+
+	memory::trace_filter filter;
+	filter.address_mask = 0xFF00;
+	filter.address_value = 0x0100;
+	filter.access_mask = 1 << static_cast<int>(memory::trace_access::write_byte);
+	filter.device_mask = 1 << 2;
+
+	std::uint64_t cycles = 0;
+	{
+		memory::bus_trace_recorder recorder({.trace_file = path, .filter = filter}, cycles);
+
+		auto unit = std::make_shared<memory::memory_unit<>>(0x1FF);
+		memory::tracing_memory traced(unit, recorder, 2);
+		memory::tracing_memory ignored(unit, recorder, 3);
+
+		for(std::uint32_t addr = 0; addr <= 0x1FF; ++addr)
+		{
+			std::uint8_t data = test::random::next<std::uint8_t>();
+			traced.init_write(addr, data);
+			ignored.init_write(addr, data);
+			traced.read_byte_now(addr);
+		}
+	}
+
+	auto records = read_trace(path);
+	ASSERT_EQ(0x100, records.size());
+
+	for(const auto& rec : records)
+	{
+		ASSERT_EQ(0x0100, rec.address & 0xFF00);
+		ASSERT_EQ(memory::trace_access::write_byte, rec.access);
+		ASSERT_EQ(2, rec.device_id);
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST(MEMORY, BUS_TRACE_REPLACE_FILE)
+{
+	const auto path = trace_path("genesis_bus_trace_replace.bin");
+
+	std::uint64_t cycles = 0;
+	for(std::uint32_t records : {0x100, 0x1})
+	{
+		memory::bus_trace_recorder recorder({.trace_file = path, .chunk_records = 0x40}, cycles);
+		for(std::uint32_t addr = 0; addr < records; ++addr)
+			recorder.record(0, memory::trace_access::read_byte, addr, 0x0);
+	}
+
+	// previous trace is replaced and the unused part of the chunk is truncated
+	auto records = read_trace(path);
+	ASSERT_EQ(1, records.size());
+	ASSERT_EQ(sizeof(memory::trace_file_header) + sizeof(memory::trace_record), std::filesystem::file_size(path));
+
+	std::filesystem::remove(path);
+}
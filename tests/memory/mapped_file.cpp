@@ -0,0 +1,81 @@
+#include "memory/mapped_file.h"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+
+using namespace genesis;
+
+
+TEST(MEMORY, MAPPED_FILE_PERSISTS_DATA)
+{
+	auto path = std::filesystem::temp_directory_path() / "__genesis_mapped_file__.srm";
+	std::filesystem::remove(path);
+
+	{
+		memory::mapped_file file(path, 0x100);
+		auto data = file.data();
+
+		// new file is filled with the fill value
+		ASSERT_EQ(0x100, data.size());
+		for(auto byte : data)
+			ASSERT_EQ(0xFF, byte);
+
+		data[0x0] = 0x12;
+		data[0xFF] = 0x34;
+	}
+
+	ASSERT_EQ(0x100, std::filesystem::file_size(path));
+
+	{
+		memory::mapped_file file(path, 0x100);
+		ASSERT_EQ(0x12, file.data()[0x0]);
+		ASSERT_EQ(0xFF, file.data()[0x1]);
+		ASSERT_EQ(0x34, file.data()[0xFF]);
+	}
+
+	// existing file of a different size keeps its data
+	{
+		memory::mapped_file file(path, 0x200);
+		ASSERT_EQ(0x12, file.data()[0x0]);
+		ASSERT_EQ(0x0, file.data()[0x1FF]);
+	}
+
+	ASSERT_EQ(0x200, std::filesystem::file_size(path));
+	std::filesystem::remove(path);
+}
+
+TEST(MEMORY, MAPPED_FILE_REGION)
+{
+	auto path = std::filesystem::temp_directory_path() / "__genesis_mapped_file_region__.bin";
+	std::filesystem::remove(path);
+
+	// offset is not aligned to the page size, file is extended with zeros
+	{
+		memory::mapped_file file(path, memory::mapped_file::region{0x1010, 0x20});
+		auto data = file.data();
+
+		ASSERT_EQ(0x20, data.size());
+		for(auto byte : data)
+			ASSERT_EQ(0x0, byte);
+
+		data[0x0] = 0x12;
+		data[0x1F] = 0x34;
+	}
+
+	ASSERT_EQ(0x1030, std::filesystem::file_size(path));
+
+	// mapping a region inside the file does not truncate it
+	{
+		memory::mapped_file file(path, memory::mapped_file::region{0x1000, 0x11});
+		ASSERT_EQ(0x12, file.data()[0x10]);
+	}
+
+	ASSERT_EQ(0x1030, std::filesystem::file_size(path));
+
+	{
+		memory::mapped_file file(path, 0x1030);
+		ASSERT_EQ(0x34, file.data()[0x102F]);
+	}
+
+	std::filesystem::remove(path);
+}
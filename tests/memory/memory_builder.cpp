@@ -1,20 +1,22 @@
 #include "memory/memory_builder.h"
 
 #include "helper.h"
+#include "memory/dummy_memory.h"
 #include "memory/memory_unit.h"
 
 #include <gtest/gtest.h>
+#include <vector>
 
 using namespace genesis;
 
-std::shared_ptr<memory::memory_unit> shared_device(std::uint32_t highest_address)
+std::shared_ptr<memory::memory_unit<>> shared_device(std::uint32_t highest_address)
 {
-	return std::make_shared<memory::memory_unit>(highest_address);
+	return std::make_shared<memory::memory_unit<>>(highest_address);
 }
 
 std::unique_ptr<memory::addressable> unique_device(std::uint32_t highest_address)
 {
-	return std::make_unique<memory::memory_unit>(highest_address);
+	return std::make_unique<memory::memory_unit<>>(highest_address);
 }
 
 std::shared_ptr<memory::addressable> build(unsigned num_devices, unsigned mem_per_device)
@@ -178,3 +180,89 @@ TEST(MEMORY, MEMORY_BUILDER_MIRROR)
 		ASSERT_EQ(data, mem->latched_byte());
 	}
 }
+
+TEST(MEMORY, MEMORY_BUILDER_READ_NOW)
+{
+	auto mem = build(4, 0x100);
+
+	for(std::uint32_t addr = 0; addr < 4 * 0x100; addr += 2)
+	{
+		std::uint16_t data = test::random::next<std::uint16_t>();
+		mem->init_write(addr, data);
+
+		ASSERT_EQ(data, mem->read_word_now(addr));
+		ASSERT_EQ(std::uint8_t(data), mem->read_byte_now(addr));
+	}
+}
+
+TEST(MEMORY, MEMORY_BUILDER_BLOCK_TRANSFER)
+{
+	const unsigned num_devices = 4;
+	const unsigned mem_per_device = 0x100;
+	auto mem = build(num_devices, mem_per_device);
+
+	// cross all device borders
+	std::vector<std::uint8_t> src(num_devices * mem_per_device - 0x10);
+	for(auto& val : src)
+		val = test::random::next<std::uint8_t>();
+
+	mem->write_block(0x8, src);
+
+	for(std::size_t i = 0; i < src.size(); ++i)
+		ASSERT_EQ(src[i], mem->read_byte_now(0x8 + i));
+
+	std::vector<std::uint8_t> dst(src.size());
+	mem->read_block(0x8, dst);
+	ASSERT_EQ(src, dst);
+}
+
+TEST(MEMORY, MEMORY_BUILDER_ADDRESS_MASK)
+{
+	const std::uint32_t MASK = 0xFF;
+
+	memory::memory_builder builder;
+	builder.add(shared_device(MASK), 0x0, 0x3FF, MASK); // [0 ; 0xFF] mirrored up to 0x3FF
+	auto mem = builder.build();
+
+	for(std::uint32_t addr = 0x300; addr <= 0x3FF; ++addr)
+	{
+		std::uint8_t data = test::random::next<std::uint8_t>();
+		mem->init_write(addr, data);
+
+		for(std::uint32_t mirror = addr & MASK; mirror <= 0x3FF; mirror += MASK + 1)
+			ASSERT_EQ(data, mem->read_byte_now(mirror));
+	}
+
+	// block crosses the mirror border
+	std::vector<std::uint8_t> src(0x20);
+	for(auto& val : src)
+		val = test::random::next<std::uint8_t>();
+
+	mem->write_block(0x1F0, src);
+
+	for(std::size_t i = 0; i < src.size(); ++i)
+		ASSERT_EQ(src[i], mem->read_byte_now((0x1F0 + i) & MASK));
+
+	std::vector<std::uint8_t> dst(src.size());
+	mem->read_block(0x2F0, dst);
+	ASSERT_EQ(src, dst);
+}
+
+TEST(MEMORY, MEMORY_BUILDER_SYNCHRONOUS_DEVICES)
+{
+	memory::memory_builder builder;
+	builder.add(shared_device(0xFF), 0x0);
+	builder.add(std::make_shared<memory::dummy_memory>(0xFF), 0x100);
+	auto mem = builder.build();
+
+	ASSERT_TRUE(mem->is_synchronous(0x0));
+	ASSERT_TRUE(mem->is_synchronous(0xFF));
+	ASSERT_FALSE(mem->is_synchronous(0x100));
+	ASSERT_FALSE(mem->is_synchronous(0x1FF));
+
+	// block transfers must not touch asynchronous devices
+	std::vector<std::uint8_t> data(0x10);
+	mem->read_block(0xF0, data);
+	ASSERT_THROW(mem->read_block(0xF8, data), std::runtime_error);
+	ASSERT_THROW(mem->write_block(0x100, data), std::runtime_error);
+}
@@ -1,8 +1,11 @@
 #include "memory/memory_unit.h"
+#include "memory/memory_builder.h"
+#include "memory/read_only_memory_unit.h"
 
 #include "../helpers/random.h"
 #include "helper.h"
 
+#include <array>
 #include <gtest/gtest.h>
 
 using namespace genesis;
@@ -11,14 +14,14 @@ using namespace genesis;
 TEST(MEMORY, MEMORY_UNIT_MAX_ADDRESS)
 {
 	const std::uint32_t highest_address = 1024;
-	memory::memory_unit unit{highest_address};
+	memory::memory_unit<> unit{highest_address};
 
 	ASSERT_EQ(highest_address, unit.max_address());
 }
 
 TEST(MEMORY, MEMORY_UNIT_IDLE)
 {
-	memory::memory_unit unit{123};
+	memory::memory_unit<> unit{123};
 
 	unit.init_read_byte(0);
 	ASSERT_TRUE(unit.is_idle());
@@ -30,7 +33,7 @@ TEST(MEMORY, MEMORY_UNIT_IDLE)
 TEST(MEMORY, MEMORY_UNIT_WRITE_8_BOUNDARIES)
 {
 	const std::uint32_t highest_address = 256;
-	memory::memory_unit unit{highest_address};
+	memory::memory_unit<> unit{highest_address};
 
 	ASSERT_NO_THROW(unit.write<std::uint8_t>(0, 0));
 	ASSERT_NO_THROW(unit.write<std::uint8_t>(highest_address, 0));
@@ -41,7 +44,7 @@ TEST(MEMORY, MEMORY_UNIT_WRITE_8_BOUNDARIES)
 TEST(MEMORY, MEMORY_UNIT_WRITE_16_BOUNDARIES)
 {
 	const std::uint32_t highest_address = 256;
-	memory::memory_unit unit{highest_address};
+	memory::memory_unit<> unit{highest_address};
 
 	ASSERT_NO_THROW(unit.write<std::uint16_t>(0, 0));
 	ASSERT_NO_THROW(unit.write<std::uint16_t>(highest_address - 1, 0));
@@ -53,7 +56,7 @@ TEST(MEMORY, MEMORY_UNIT_WRITE_16_BOUNDARIES)
 TEST(MEMORY, MEMORY_UNIT_READ_8_BOUNDARIES)
 {
 	const std::uint32_t highest_address = 256;
-	memory::memory_unit unit{highest_address};
+	memory::memory_unit<> unit{highest_address};
 
 	ASSERT_NO_THROW(unit.init_read_byte(0));
 	ASSERT_NO_THROW(unit.init_read_byte(highest_address));
@@ -64,7 +67,7 @@ TEST(MEMORY, MEMORY_UNIT_READ_8_BOUNDARIES)
 TEST(MEMORY, MEMORY_UNIT_READ_16_BOUNDARIES)
 {
 	const std::uint32_t highest_address = 256;
-	memory::memory_unit unit{highest_address};
+	memory::memory_unit<> unit{highest_address};
 
 	ASSERT_NO_THROW(unit.init_read_word(0));
 	ASSERT_NO_THROW(unit.init_read_word(highest_address - 1));
@@ -75,23 +78,23 @@ TEST(MEMORY, MEMORY_UNIT_READ_16_BOUNDARIES)
 
 TEST(MEMORY, MEMORY_UNIT_READ_WRITE_8)
 {
-	memory::memory_unit unit{256};
+	memory::memory_unit<> unit{256};
 	test::test_read_write<std::uint8_t>(unit);
 }
 
 TEST(MEMORY, MEMORY_UNIT_READ_WRITE_16)
 {
-	memory::memory_unit unit_le{256, std::endian::little};
+	memory::memory_unit<std::endian::little> unit_le{256};
 	test::test_read_write<std::uint16_t>(unit_le);
 
-	memory::memory_unit unit_be{256, std::endian::big};
+	memory::memory_unit<std::endian::big> unit_be{256};
 	test::test_read_write<std::uint16_t>(unit_be);
 }
 
 TEST(MEMORY, MEMORY_UNIT_BIG_ENDIAN)
 {
 	const int num_batches = 10;
-	memory::memory_unit unit{32, std::endian::big};
+	memory::memory_unit<std::endian::big> unit{32};
 
 	for(int i = 0; i < num_batches; ++i)
 	{
@@ -113,7 +116,7 @@ TEST(MEMORY, MEMORY_UNIT_BIG_ENDIAN)
 TEST(MEMORY, MEMORY_UNIT_LITTLE_ENDIAN)
 {
 	const int num_batches = 10;
-	memory::memory_unit unit{32, std::endian::little};
+	memory::memory_unit<std::endian::little> unit{32};
 
 	for(int i = 0; i < num_batches; ++i)
 	{
@@ -134,48 +137,99 @@ TEST(MEMORY, MEMORY_UNIT_LITTLE_ENDIAN)
 
 TEST(MEMORY, MEMORY_UNIT_LATCHED_DATA_WITHOUT_READ)
 {
-	memory::memory_unit unit{32};
+	// latch is checked in debug builds only
+	memory::memory_unit<> unit{32};
 
-	ASSERT_THROW(unit.latched_byte(), std::exception);
-	ASSERT_THROW(unit.latched_word(), std::exception);
+	ASSERT_DEBUG_DEATH(unit.latched_byte(), "");
+	ASSERT_DEBUG_DEATH(unit.latched_word(), "");
 }
 
 TEST(MEMORY, MEMORY_UNIT_LATCHED_DATA_AFTER_WRITE_8)
 {
-	memory::memory_unit unit{32};
+	memory::memory_unit<> unit{32};
 
 	unit.init_read_byte(0);
 	unit.init_write(0, std::uint8_t(0));
 
-	ASSERT_THROW(unit.latched_byte(), std::exception);
-	ASSERT_THROW(unit.latched_word(), std::exception);
+	ASSERT_DEBUG_DEATH(unit.latched_byte(), "");
+	ASSERT_DEBUG_DEATH(unit.latched_word(), "");
 }
 
 TEST(MEMORY, MEMORY_UNIT_LATCHED_DATA_AFTER_WRITE_16)
 {
-	memory::memory_unit unit{32};
+	memory::memory_unit<> unit{32};
 
 	unit.init_read_word(0);
 	unit.init_write(0, std::uint16_t(0));
 
-	ASSERT_THROW(unit.latched_byte(), std::exception);
-	ASSERT_THROW(unit.latched_word(), std::exception);
+	ASSERT_DEBUG_DEATH(unit.latched_byte(), "");
+	ASSERT_DEBUG_DEATH(unit.latched_word(), "");
 }
 
 TEST(MEMORY, MEMORY_UNIT_LATCHED_BYTE_AFTER_READING_WORD)
 {
-	memory::memory_unit unit{32};
+	memory::memory_unit<> unit{32};
 
 	unit.init_read_word(0);
 
-	ASSERT_THROW(unit.latched_byte(), std::exception);
+	ASSERT_DEBUG_DEATH(unit.latched_byte(), "");
 }
 
 TEST(MEMORY, MEMORY_UNIT_LATCHED_WORD_AFTER_READING_BYTE)
 {
-	memory::memory_unit unit{32};
+	memory::memory_unit<> unit{32};
 
 	unit.init_read_byte(0);
 
-	ASSERT_THROW(unit.latched_word(), std::exception);
+	ASSERT_DEBUG_DEATH(unit.latched_word(), "");
+}
+
+TEST(MEMORY, MEMORY_UNIT_READ_NOW)
+{
+	memory::memory_unit<std::endian::big> unit{32};
+	unit.write<std::uint16_t>(4, 0x1234);
+
+	ASSERT_EQ(0x1234, unit.read_word_now(4));
+	ASSERT_EQ(0x12, unit.read_byte_now(4));
+	ASSERT_EQ(0x34, unit.read_byte_now(5));
+
+	unit.init_read_word(4);
+	ASSERT_EQ(unit.read_word_now(4), unit.latched_word());
+}
+
+TEST(MEMORY, MEMORY_UNIT_BLOCK_TRANSFER)
+{
+	memory::memory_unit<std::endian::big> unit{32};
+
+	std::array<std::uint8_t, 8> src = {1, 2, 3, 4, 5, 6, 7, 8};
+	unit.write_block(8, src);
+
+	ASSERT_EQ(0x0102, unit.read<std::uint16_t>(8));
+	ASSERT_EQ(0x08, unit.read<std::uint8_t>(15));
+
+	std::array<std::uint8_t, 8> dst{};
+	unit.read_block(8, dst);
+	ASSERT_EQ(src, dst);
+
+	ASSERT_THROW(unit.read_block(30, dst), std::runtime_error);
+	ASSERT_THROW(unit.write_block(30, src), std::runtime_error);
+}
+
+TEST(MEMORY, READ_ONLY_MEMORY_UNIT_BLOCK_TRANSFER)
+{
+	auto unit = std::make_shared<memory::read_only_memory_unit<std::endian::big>>(std::uint32_t(31));
+
+	std::array<std::uint8_t, 4> src = {1, 2, 3, 4};
+	ASSERT_THROW(unit->write_block(0, src), std::runtime_error);
+
+	// block writes through a memory map must not bypass the check either
+	memory::memory_builder builder;
+	builder.add(unit, 0x100, 0x11F);
+	auto map = builder.build();
+
+	ASSERT_THROW(map->write_block(0x100, src), std::runtime_error);
+
+	std::array<std::uint8_t, 4> dst = {0xFF, 0xFF, 0xFF, 0xFF};
+	unit->read_block(0, dst);
+	ASSERT_EQ((std::array<std::uint8_t, 4>{}), dst);
 }
@@ -0,0 +1,71 @@
+#include "perf_counters.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace genesis;
+
+
+TEST(PERF_COUNTERS, GET_RETURNS_SAME_COUNTER)
+{
+	auto& reg = perf::registry::instance();
+
+	auto& c1 = reg.get("tests.counter_a");
+	c1.add(5);
+
+	auto& c2 = reg.get("tests.counter_a");
+	c2.add(10);
+
+	ASSERT_EQ(&c1, &c2);
+	ASSERT_EQ(15, reg.value("tests.counter_a"));
+}
+
+TEST(PERF_COUNTERS, REFERENCES_ARE_STABLE)
+{
+	auto& reg = perf::registry::instance();
+
+	auto& first = reg.get("tests.stable");
+	for(int i = 0; i < 1000; ++i)
+		reg.get("tests.stable_" + std::to_string(i));
+
+	first.add(1);
+	ASSERT_EQ(&first, &reg.get("tests.stable"));
+}
+
+TEST(PERF_COUNTERS, RESET)
+{
+	auto& reg = perf::registry::instance();
+
+	reg.get("tests.reset").add(42);
+	reg.reset();
+
+	ASSERT_EQ(0, reg.value("tests.reset"));
+	ASSERT_EQ(0, reg.value("tests.non_existing_counter"));
+}
+
+TEST(PERF_COUNTERS, DUMP)
+{
+	auto& reg = perf::registry::instance();
+	reg.get("tests.dump").add(123);
+
+	std::stringstream ss;
+	reg.dump(ss);
+
+	auto str = ss.str();
+	ASSERT_NE(str.find("tests.dump"), std::string::npos);
+	ASSERT_NE(str.find("123"), std::string::npos);
+}
+
+TEST(PERF_COUNTERS, MACROS)
+{
+	auto& reg = perf::registry::instance();
+	reg.reset();
+
+	for(int i = 0; i < 10; ++i)
+		GENESIS_PERF_INC("tests.macro");
+
+	if constexpr(perf::enabled)
+		ASSERT_EQ(10, reg.value("tests.macro"));
+	else
+		ASSERT_EQ(0, reg.value("tests.macro"));
+}
@@ -297,3 +297,25 @@ TEST(ROM, CORRUPTED_INPUT)
 	/* empty body */
 	check_ill_formatted_rom(raw_vectors, raw_header, empty_array);
 }
+
+TEST(ROM, SRAM_HEADER)
+{
+	auto header = builtin_rom::raw_header;
+
+	// "RA", battery backed SRAM at odd addresses $200001-$203FFF
+	const std::array<std::uint8_t, 12> extra_memory = {0x52, 0x41, 0xF8, 0x20, 0x00, 0x20, 0x00, 0x01,
+													   0x00, 0x20, 0x3F, 0xFF};
+	std::copy(extra_memory.begin(), extra_memory.end(), header.begin() + 0xB0);
+
+	ROMConstructor rom(builtin_rom::raw_vectors, header, builtin_rom::raw_body);
+	genesis::rom test_rom(rom.path());
+
+	ASSERT_TRUE(test_rom.header().sram.has_value());
+	ASSERT_EQ(0x200001, test_rom.header().sram->start_addr);
+	ASSERT_EQ(0x203FFF, test_rom.header().sram->end_addr);
+
+	// EEPROM is not reported as SRAM
+	header[0xB3] = 0x40;
+	ROMConstructor eeprom_rom(builtin_rom::raw_vectors, header, builtin_rom::raw_body);
+	ASSERT_FALSE(genesis::rom(eeprom_rom.path()).header().sram.has_value());
+}
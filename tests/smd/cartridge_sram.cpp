@@ -0,0 +1,83 @@
+#include "smd/impl/cartridge_sram.h"
+
+#include "memory/memory_unit.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace genesis;
+
+
+namespace
+{
+
+constexpr std::uint32_t sram_start = 0x1;
+
+struct cartridge
+{
+	cartridge(bool sram_enabled)
+	{
+		rom = std::make_shared<memory::memory_unit<std::endian::big>>(0x3FFFFF);
+		for(std::uint32_t addr = 0; addr <= 0x3FFFFF; addr += 2)
+			rom->write<std::uint16_t>(addr, 0xABCD);
+
+		sram.resize(0x4000, 0x00);
+		control = std::make_shared<impl::sram_control_register>(sram_enabled);
+		area = std::make_shared<impl::cartridge_sram_area>(rom, sram, sram_start, control);
+	}
+
+	std::shared_ptr<memory::memory_unit<std::endian::big>> rom;
+	std::vector<std::uint8_t> sram;
+	std::shared_ptr<impl::sram_control_register> control;
+	std::shared_ptr<impl::cartridge_sram_area> area;
+};
+
+} // namespace
+
+
+TEST(SMD_SRAM, READ_WRITE)
+{
+	cartridge cart(true);
+
+	cart.area->init_write(sram_start, std::uint8_t(0x12));
+	cart.area->init_write(sram_start + 2, std::uint8_t(0x34));
+	ASSERT_EQ(0x12, cart.sram[0]);
+	ASSERT_EQ(0x34, cart.sram[2]);
+
+	cart.area->init_read_byte(sram_start + 2);
+	ASSERT_EQ(0x34, cart.area->latched_byte());
+	ASSERT_EQ(0x12, cart.area->read_byte_now(sram_start));
+
+	// ROM is visible outside of SRAM
+	ASSERT_EQ(0xABCD, cart.area->read_word_now(0x10000));
+}
+
+TEST(SMD_SRAM, CONTROL_REGISTER)
+{
+	cartridge cart(false);
+
+	// ROM is mapped till SRAM is enabled
+	cart.area->init_write(sram_start + 1, std::uint16_t(0x1234));
+	ASSERT_EQ(0x1234, cart.rom->read<std::uint16_t>(0x200002));
+	ASSERT_EQ(0x00, cart.sram[1]);
+
+	cart.control->init_write(0x1, std::uint8_t(0b01));
+	ASSERT_TRUE(cart.control->sram_enabled());
+
+	cart.area->init_write(sram_start + 1, std::uint16_t(0x5678));
+	ASSERT_EQ(0x56, cart.sram[1]);
+	ASSERT_EQ(0x78, cart.sram[2]);
+	ASSERT_EQ(0x5678, cart.area->read_word_now(sram_start + 1));
+
+	// write protection
+	cart.control->init_write(0x1, std::uint8_t(0b11));
+	cart.area->init_write(sram_start + 1, std::uint16_t(0x9ABC));
+	ASSERT_EQ(0x5678, cart.area->read_word_now(sram_start + 1));
+
+	// even byte of the register is not connected
+	cart.control->init_write(0x0, std::uint8_t(0b00));
+	ASSERT_TRUE(cart.control->sram_enabled());
+
+	cart.control->init_write(0x1, std::uint8_t(0b00));
+	ASSERT_EQ(0x1234, cart.area->read_word_now(sram_start + 1));
+}
@@ -0,0 +1,58 @@
+#include "static_queue.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace genesis;
+
+
+TEST(StaticQueue, Fifo)
+{
+	static_queue<int, 4> queue;
+	ASSERT_TRUE(queue.empty());
+
+	queue.push(1);
+	queue.push(2);
+	queue.emplace(3);
+
+	ASSERT_EQ(3, queue.size());
+	for(int expected : {1, 2, 3})
+	{
+		ASSERT_EQ(expected, queue.front());
+		queue.pop();
+	}
+
+	ASSERT_TRUE(queue.empty());
+}
+
+
+TEST(StaticQueue, WrapsAround)
+{
+	static_queue<int, 4> queue;
+
+	for(int i = 0; i < 100; ++i)
+	{
+		queue.push(i);
+		queue.push(i + 1);
+
+		ASSERT_EQ(i, queue.front());
+		queue.pop();
+		ASSERT_EQ(i + 1, queue.front());
+		queue.pop();
+	}
+
+	ASSERT_TRUE(queue.empty());
+}
+
+
+TEST(StaticQueue, Overflow)
+{
+	static_queue<int, 2> queue;
+	queue.push(1);
+	queue.push(2);
+
+	ASSERT_TRUE(queue.full());
+	ASSERT_THROW(queue.push(3), internal_error);
+
+	queue.clear();
+	ASSERT_TRUE(queue.empty());
+}
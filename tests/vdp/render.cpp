@@ -655,3 +655,66 @@ TEST(VDP_RENDERER, ACTIVE_LINE_H_SCROLLING)
 		}
 	}
 }
+
+TEST(VDP_RENDER, SPRITE_PATTERNS_WRAP_AROUND_VRAM)
+{
+	vdp vdp;
+	renderer_builder builder(vdp);
+	auto& vram = vdp.vram();
+	auto& cram = vdp.cram();
+
+	// 4x4 sprite at the sprite table start ($0), which uses the last pattern ($7FF)
+	vram.write<std::uint16_t>(0x0, 0);		// vertical position
+	vram.write<std::uint8_t>(0x2, 0b1111);	// size
+	vram.write<std::uint8_t>(0x3, 0);		// link
+	vram.write<std::uint16_t>(0x4, 0x07FF); // pattern index
+	vram.write<std::uint16_t>(0x6, 0);		// horizontal position
+
+	// the last line of the bottom row patterns goes past $FFFF and wraps to $0040, $00C0, $0140, $01C0
+	const std::array<std::uint32_t, 4> lines = {0x0000005C, 0x000000DC, 0x0000015C, 0x000001DC};
+	for(std::uint8_t i = 0; i < lines.size(); ++i)
+	{
+		std::uint8_t color_id = i + 1;
+		for(std::uint32_t byte = 0; byte < 4; ++byte)
+			vram.write<std::uint8_t>(lines[i] + byte, (color_id << 4) | color_id);
+
+		cram.write(color_id * 2, 0x100 + color_id);
+	}
+
+	auto row = vdp.render().get_sprite_row(31, plane_buffer);
+	for(std::size_t col = 0; col < 32; ++col)
+		ASSERT_EQ(0x100 + (col / 8) + 1, row[col]) << "column: " << col;
+}
+
+TEST(VDP_RENDER, LARGE_PLANE_WRAPS_AROUND_VRAM)
+{
+	vdp vdp;
+	auto& vram = vdp.vram();
+	auto& regs = vdp.registers();
+
+	// 128x64 plane at $E000 occupies [$E000; $16000)
+	regs.R16.W = 0b11;
+	regs.R16.H = 0b01;
+	ASSERT_EQ(0xE000, set_plane_address(vdp, plane_type::a, 0b111));
+
+	auto tail = random_tail();
+	const std::uint32_t tail_address = 0x1000;
+	copy_tail(vdp, tail_address, tail);
+
+	// row 32 starts right past $FFFF and wraps to $0000
+	const std::uint8_t palette = 1;
+	for(std::uint32_t entry = 0; entry < 128; ++entry)
+		vram.write(entry * 2, get_plane_entry(tail_address, false, false, palette));
+
+	fill_cram(vdp);
+
+	const int row_number = 32 * 8;
+	auto row = get_plane_row(vdp, plane_type::a, row_number);
+	ASSERT_EQ(128 * 8, row.size());
+
+	for(std::size_t col = 0; col < row.size(); ++col)
+	{
+		auto expected = read_color(vdp, palette, tail.at(get_tail_index(0, col % 8)));
+		ASSERT_EQ(expected, row[col]) << "column: " << col;
+	}
+}
@@ -12,10 +12,10 @@ namespace genesis::test
 class mock_m68k_bus_access : public vdp::m68k_bus_access
 {
 public:
-	using m68k_memory_t = memory::memory_unit;
+	using m68k_memory_t = memory::memory_unit<std::endian::big>;
 
 public:
-	mock_m68k_bus_access() : m68k_memory(0xFFFF, std::endian::big)
+	mock_m68k_bus_access() : m68k_memory(0xFFFF)
 	{
 	}
 
@@ -92,7 +92,7 @@ private:
 	bool has_access = false;
 	std::optional<std::uint16_t> data = 0;
 
-	memory::memory_unit m68k_memory;
+	m68k_memory_t m68k_memory;
 
 	int cycles_to_idle = 0;
 };
@@ -0,0 +1,89 @@
+#include "z80/cpu.h"
+
+#include "memory/memory_builder.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace genesis;
+
+
+// NOPs everywhere, RAM at [0x0 ; 0x1FFF] is accessed directly
+static z80::cpu build_cpu(std::shared_ptr<std::vector<std::uint8_t>> ram)
+{
+	memory::memory_builder builder;
+	builder.add_unique(std::make_unique<memory::memory_unit<std::endian::little>>(ram), 0x0, 0x1FFF);
+	builder.add_unique(memory::make_memory_unit<std::endian::little>(0xDFFF), 0x2000, 0xFFFF);
+
+	auto mem = std::make_shared<z80::memory>(builder.build());
+	mem->set_direct_ram(*ram, 0x2000);
+
+	return z80::cpu(mem);
+}
+
+TEST(Z80Breakpoints, StopBeforeExecution)
+{
+	auto ram = std::make_shared<std::vector<std::uint8_t>>(0x2000);
+	auto cpu = build_cpu(ram);
+
+	std::vector<break_event> events;
+	cpu.on_break([&](const break_event& ev) { events.push_back(ev); });
+	cpu.add_breakpoint(break_type::execution, 0x10);
+
+	while(events.empty())
+	{
+		ASSERT_LE(cpu.registers().PC, 0x10);
+		cpu.execute_one();
+	}
+
+	ASSERT_EQ(break_type::execution, events[0].type);
+	ASSERT_EQ(0x10, events[0].address);
+	ASSERT_EQ(0x10, cpu.registers().PC);
+
+	// resume
+	cpu.execute_one();
+	ASSERT_EQ(0x11, cpu.registers().PC);
+	ASSERT_EQ(1, events.size());
+
+	cpu.clear_breakpoints();
+	cpu.registers().PC = 0x0;
+	for(int i = 0; i < 0x20; ++i)
+		cpu.execute_one();
+	ASSERT_EQ(1, events.size());
+}
+
+TEST(Z80Breakpoints, WatchDirectRam)
+{
+	auto ram = std::make_shared<std::vector<std::uint8_t>>(0x2000);
+	auto cpu = build_cpu(ram);
+
+	const std::uint16_t data_addr = 0x1000;
+
+	// LD (0x1000), A ; LD A, (0x1001)
+	const std::vector<std::uint8_t> program = {0x32, 0x00, 0x10, 0x3A, 0x01, 0x10};
+	std::copy(program.begin(), program.end(), ram->begin());
+
+	std::vector<break_event> events;
+	cpu.on_break([&](const break_event& ev) { events.push_back(ev); });
+	cpu.add_breakpoint(break_type::write, data_addr);
+	cpu.add_breakpoint(break_type::read, data_addr + 1);
+
+	cpu.execute_one();
+	ASSERT_EQ(1, events.size());
+	ASSERT_EQ(break_type::write, events[0].type);
+	ASSERT_EQ(data_addr, events[0].address);
+
+	cpu.execute_one();
+	ASSERT_EQ(2, events.size());
+	ASSERT_EQ(break_type::read, events[1].type);
+	ASSERT_EQ(data_addr + 1, events[1].address);
+
+	// direct RAM access is restored once watchpoints are removed
+	cpu.remove_breakpoint(break_type::write, data_addr);
+	cpu.remove_breakpoint(break_type::read, data_addr + 1);
+
+	cpu.registers().PC = 0x0;
+	cpu.execute_one();
+	cpu.execute_one();
+	ASSERT_EQ(2, events.size());
+}
@@ -0,0 +1,57 @@
+#include "z80/memory.h"
+
+#include "memory/memory_builder.h"
+
+#include <gtest/gtest.h>
+
+using namespace genesis;
+
+
+// RAM at [0x0 ; 0x1FFF] mirrored at [0x2000 ; 0x3FFF], the rest is regular memory
+static std::shared_ptr<memory::addressable> build_memory_map(std::shared_ptr<std::vector<std::uint8_t>> ram)
+{
+	memory::memory_builder builder;
+	builder.add_unique(std::make_unique<memory::memory_unit<std::endian::little>>(ram), 0x0, 0x1FFF);
+	builder.mirror(0x0, 0x1FFF, 0x2000, 0x3FFF);
+	builder.add_unique(memory::make_memory_unit<std::endian::little>(0xBFFF), 0x4000, 0xFFFF);
+	return builder.build();
+}
+
+TEST(Z80Memory, DirectRamMatchesBus)
+{
+	auto ram = std::make_shared<std::vector<std::uint8_t>>(0x2000);
+	auto map = build_memory_map(ram);
+
+	z80::memory bus_mem(map);
+	z80::memory direct_mem(map);
+	direct_mem.set_direct_ram(*ram, 0x4000);
+
+	for(std::uint32_t addr = 0; addr <= 0x4010; addr += 0x7)
+	{
+		bus_mem.write<std::uint16_t>(addr, addr ^ 0x5A5A);
+		ASSERT_EQ(bus_mem.read<std::uint16_t>(addr), direct_mem.read<std::uint16_t>(addr));
+		ASSERT_EQ(bus_mem.read<std::int8_t>(addr + 1), direct_mem.read<std::int8_t>(addr + 1));
+
+		direct_mem.write<std::int16_t>(addr, addr ^ 0xA5A5);
+		ASSERT_EQ(bus_mem.read<std::uint16_t>(addr), direct_mem.read<std::uint16_t>(addr));
+	}
+}
+
+TEST(Z80Memory, DirectRamIsMirrored)
+{
+	auto ram = std::make_shared<std::vector<std::uint8_t>>(0x2000);
+	z80::memory mem(build_memory_map(ram));
+	mem.set_direct_ram(*ram, 0x4000);
+
+	mem.write<std::uint16_t>(0x2100, 0x1234);
+	ASSERT_EQ(0x1234, mem.read<std::uint16_t>(0x0100));
+	ASSERT_EQ(0x34, (*ram)[0x0100]);
+	ASSERT_EQ(0x12, (*ram)[0x0101]);
+}
+
+TEST(Z80Memory, DirectRamSizeMustBePowerOf2)
+{
+	std::vector<std::uint8_t> ram(0x1000 + 1);
+	z80::memory mem;
+	ASSERT_THROW(mem.set_direct_ram(ram, 0x1000), std::invalid_argument);
+}